@@ -0,0 +1,10 @@
+#include <stdio.h>
+#include <string.h>
+#include "bench_list.h"
+
+/* Usage: bench [record|compare] [baseline path] */
+int main(int argc, char** argv) {
+    const bool is_recording = argc > 1 && !strcmp(argv[1], "record");
+    const char* baseline_path = argc > 2? argv[2]: "bench/baseline.txt";
+    return bench_list(baseline_path, is_recording)? 0: 1;
+}
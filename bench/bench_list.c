@@ -0,0 +1,261 @@
+#include <bench.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "bench_list.h"
+
+#define LIST_CALLOC bench_calloc
+#define LIST_REALLOC bench_realloc
+#define LIST_FREE bench_free
+#include <list.h>
+
+#define BENCH_LIST_LENGTH 1024
+
+LIST_DEFINE_STRUCT(int, int, );
+LIST_DEFINE_GETTER(int, int, static inline);
+LIST_DEFINE_SETTER(int, int, static inline);
+
+/* Sink that keeps the compiler from discarding the measured operations. */
+static volatile int bench_list_sink = 0;
+
+/* Read-only fixtures, filled once before measuring. */
+static int bench_list_array[BENCH_LIST_LENGTH];
+static struct int_list bench_list_fixture_a = {0};
+static struct int_list bench_list_fixture_b = {0};
+
+static void bench_list_new(bench_uint p_count);
+static void bench_list_from_array(bench_uint p_count);
+static void bench_list_get(bench_uint p_count);
+static void bench_list_find(bench_uint p_count);
+static void bench_list_equal(bench_uint p_count);
+static void bench_list_append(bench_uint p_count);
+static void bench_list_prepend(bench_uint p_count);
+static void bench_list_insert(bench_uint p_count);
+static void bench_list_erase(bench_uint p_count);
+static void bench_list_pop_back(bench_uint p_count);
+
+/* >> bench_list
+ *  entrance for benchmarking list.
+ *
+ * @param 
+ *  `p_baseline_path` - Path of the baseline file.
+ *  `p_is_recording` - `true` records baseline, `false` compares with it.
+ *
+ * @return 
+ *  % - `true` when nothing regressed, else `false`.
+ *
+ * @noerror
+ * <<
+ * */
+bool bench_list(const char* p_baseline_path, bool p_is_recording) {
+    for(int i = 0; i < BENCH_LIST_LENGTH; i++) bench_list_array[i] = i;
+    int_list_from_array(bench_list_array, BENCH_LIST_LENGTH, &bench_list_fixture_a);
+    int_list_from_array(bench_list_array, BENCH_LIST_LENGTH, &bench_list_fixture_b);
+
+    bench_start("Bench list.", p_baseline_path, p_is_recording);
+    bench("list_new", bench_list_new, 4096, 0.25);
+    bench("list_from_array", bench_list_from_array, 4096, 0.25);
+    bench("list_get", bench_list_get, 1 << 16, 0.25);
+    bench("list_find", bench_list_find, 256, 0.25);
+    bench("list_equal", bench_list_equal, 256, 0.25);
+    bench("list_append", bench_list_append, 1 << 14, 0.25);
+    bench("list_prepend", bench_list_prepend, BENCH_LIST_LENGTH, 0.25);
+    bench("list_insert", bench_list_insert, BENCH_LIST_LENGTH, 0.25);
+    bench("list_erase", bench_list_erase, BENCH_LIST_LENGTH, 0.25);
+    bench("list_pop_back", bench_list_pop_back, BENCH_LIST_LENGTH, 0.25);
+    const bool result = bench_end();
+
+    int_list_free_items(&bench_list_fixture_a);
+    int_list_free_items(&bench_list_fixture_b);
+    return result;
+}
+
+/* >> bench_list_new
+ *  Bench `ID_list_new` & `ID_list_free` functions.
+ *
+ * @param 
+ *  `p_count` - Number of operations.
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void bench_list_new(bench_uint p_count) {
+    for(bench_uint i = 0; i < p_count; i++) {
+        struct int_list* list = int_list_new();
+        bench_list_sink += list->length;
+        int_list_free(list);
+    }
+}
+
+/* >> bench_list_from_array
+ *  Bench `ID_list_from_array` function on a small array.
+ *
+ * @param 
+ *  `p_count` - Number of operations.
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void bench_list_from_array(bench_uint p_count) {
+    const int array[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    for(bench_uint i = 0; i < p_count; i++) {
+        struct int_list list = {0};
+        int_list_from_array(array, sizeof(array) / sizeof(array[0]), &list);
+        bench_list_sink += list.items[i % list.length];
+        int_list_free_items(&list);
+    }
+}
+
+/* >> bench_list_get
+ *  Bench `ID_list_get` function.
+ *
+ * @param 
+ *  `p_count` - Number of operations.
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void bench_list_get(bench_uint p_count) {
+    int item = 0;
+    for(bench_uint i = 0; i < p_count; i++) {
+        int_list_get(&bench_list_fixture_a, i % BENCH_LIST_LENGTH, &item);
+        bench_list_sink += item;
+    }
+}
+
+/* >> bench_list_find
+ *  Bench `ID_list_find` function with item at the back of the list.
+ *
+ * @param 
+ *  `p_count` - Number of operations.
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void bench_list_find(bench_uint p_count) {
+    list_uint index = 0;
+    for(bench_uint i = 0; i < p_count; i++) {
+        int_list_find(&bench_list_fixture_a, BENCH_LIST_LENGTH - 1 - (int)(i % 16), 0, &index);
+        bench_list_sink += index;
+    }
+}
+
+/* >> bench_list_equal
+ *  Bench `ID_list_equal` function with equal lists.
+ *
+ * @param 
+ *  `p_count` - Number of operations.
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void bench_list_equal(bench_uint p_count) {
+    for(bench_uint i = 0; i < p_count; i++)
+        bench_list_sink += int_list_equal(&bench_list_fixture_a, &bench_list_fixture_b);
+}
+
+/* >> bench_list_append
+ *  Bench `ID_list_append` function, growing from an empty list.
+ *
+ * @param 
+ *  `p_count` - Number of operations.
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void bench_list_append(bench_uint p_count) {
+    struct int_list list = {0};
+    for(bench_uint i = 0; i < p_count; i++) int_list_append(&list, (int)i);
+    bench_list_sink += list.length;
+    int_list_free_items(&list);
+}
+
+/* >> bench_list_prepend
+ *  Bench `ID_list_prepend` function, growing from an empty list.
+ *
+ * @param 
+ *  `p_count` - Number of operations.
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void bench_list_prepend(bench_uint p_count) {
+    struct int_list list = {0};
+    for(bench_uint i = 0; i < p_count; i++) int_list_prepend(&list, (int)i);
+    bench_list_sink += list.length;
+    int_list_free_items(&list);
+}
+
+/* >> bench_list_insert
+ *  Bench `ID_list_insert` function at the middle of the list.
+ *
+ * @param 
+ *  `p_count` - Number of operations.
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void bench_list_insert(bench_uint p_count) {
+    struct int_list list = {0};
+    for(bench_uint i = 0; i < p_count; i++) int_list_insert(&list, (int)i, list.length / 2);
+    bench_list_sink += list.length;
+    int_list_free_items(&list);
+}
+
+/* >> bench_list_erase
+ *  Bench `ID_list_erase` function at the middle of the list.
+ *  `p_count` must not exceed `BENCH_LIST_LENGTH`.
+ *
+ * @param 
+ *  `p_count` - Number of operations.
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void bench_list_erase(bench_uint p_count) {
+    struct int_list list = {0};
+    int_list_from_array(bench_list_array, p_count, &list);
+    for(bench_uint i = 0; i < p_count; i++) int_list_erase(&list, list.length / 2);
+    bench_list_sink += list.length;
+    int_list_free_items(&list);
+}
+
+/* >> bench_list_pop_back
+ *  Bench `ID_list_pop_back` function.
+ *  `p_count` must not exceed `BENCH_LIST_LENGTH`.
+ *
+ * @param 
+ *  `p_count` - Number of operations.
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void bench_list_pop_back(bench_uint p_count) {
+    struct int_list list = {0};
+    int popped = 0;
+    int_list_from_array(bench_list_array, p_count, &list);
+    for(bench_uint i = 0; i < p_count; i++) {
+        int_list_pop_back(&list, &popped);
+        bench_list_sink += popped;
+    }
+    int_list_free_items(&list);
+}
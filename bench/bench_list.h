@@ -0,0 +1,8 @@
+#ifndef _BENCH_LIST_H_
+#define _BENCH_LIST_H_
+
+#include <stdbool.h>
+
+bool bench_list(const char* p_baseline_path, bool p_is_recording); 
+
+#endif //_BENCH_LIST_H_
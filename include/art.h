@@ -0,0 +1,855 @@
+#ifndef _ART_H_
+#define _ART_H_
+
+/* # art
+ * This file contains macro for declaring and defining adaptive radix tree
+ * (ART) that maps byte-string keys to desired type, for exact, prefix and
+ * range lookups. A lookup walks one node per key byte at most, so it costs
+ * O(key length) regardless of the number of keys.
+ *
+ * ## Usage
+ * 1. Declare & define the tree with the macros. `mp_id`, `mp_type` and
+ * `mp_keyword` mean the same as in `list.h`.
+ * 2. Initialize the tree on stack or as global, `struct ID_art art = {0};`.
+ * 3. Insert, get & erase items by key (`ID_art_insert`, `ID_art_get`,
+ * `ID_art_erase`). Keys are arrays of bytes with length, so they may contain
+ * any byte and may be prefix of one another, e.g. for C string:
+ *  int_art_insert(&art, (const uint8_t*)"/home", 5, 1, NULL);
+ * 4. Visit the items in key order with `ID_art_each_prefix` or
+ * `ID_art_each_range`, through a callback of `ID_art_callback`.
+ * 5. Free the tree with `ID_art_free_items`.
+ *
+ * ## Layout
+ * An inner node has up to 4, 16, 48 or 256 children, and grows or shrinks
+ * into the next size as children are added or removed:
+ *  node4 & node16 - sorted key bytes & children, node16 is searched with one
+ *  SSE2 instruction (or a portable loop).
+ *  node48 - child index by key byte, then up to 48 children.
+ *  node256 - child by key byte.
+ * A node keeps the bytes shared by all keys under it as its prefix, up to
+ * `ART_PREFIX_LENGTH` bytes; longer shared parts take a chain of nodes. A
+ * subtree of one key is just the leaf, which holds the whole key. A key that
+ * ends at a node is kept in the node itself.
+ *
+ * ## Memory
+ * Nodes are drawn from pools of `pool.h` (one per size) embedded in the tree,
+ * so they don't hit the allocator per node. Leaves are allocated through
+ * `LIST_CALLOC` and `LIST_FREE` of `list.h`, with the key inline. */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "list.h"
+#include "pool.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define ART_NODE4 0
+#define ART_NODE16 1
+#define ART_NODE48 2
+#define ART_NODE256 3
+
+/* At most 255. */
+#ifndef ART_PREFIX_LENGTH
+#define ART_PREFIX_LENGTH 12
+#endif //ART_PREFIX_LENGTH
+
+/* Index of `p_byte` in the keys of node16, or -1. */
+static inline int art_node16_find(const uint8_t* p_keys, uint16_t p_count, uint8_t p_byte) {
+#ifdef __SSE2__
+    const __m128i keys = _mm_loadu_si128((const __m128i*)p_keys);
+    const uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(keys, _mm_set1_epi8((char)p_byte))) & ((1u << p_count) - 1);
+    return mask? __builtin_ctz(mask): -1;
+#else
+    for(uint16_t i = 0; i < p_count; i++) if(p_keys[i] == p_byte) return i;
+    return -1;
+#endif
+}
+
+/* Index of the first key not less than `p_byte` in sorted keys. */
+static inline uint16_t art_lower_bound(const uint8_t* p_keys, uint16_t p_count, uint8_t p_byte) {
+    uint16_t index = 0;
+    while(index < p_count && p_keys[index] < p_byte) index++;
+    return index;
+}
+
+/* Lexicographic order of byte strings, like `memcmp`. */
+static inline int art_compare(const uint8_t* p_a, list_uint p_a_length, const uint8_t* p_b, list_uint p_b_length) {
+    const list_uint length = p_a_length < p_b_length? p_a_length: p_b_length;
+    const int result = length? memcmp(p_a, p_b, length): 0;
+    if(result) return result;
+    return (p_a_length > p_b_length) - (p_a_length < p_b_length);
+}
+
+/* # art structure
+ * >> ID_art_callback
+ *  Callback of the visiting functions, receives the key & item of every
+ *  visited item. Returns `false` to stop visiting. Defined by
+ *  `ART_DEFINE_STRUCT` only, the declared functions spell the type out.
+ * <<
+ * >> struct ID_art_leaf
+ *
+ * @member
+ *  `item` - Item.
+ *  `length` - Length of the key.
+ *  `key` - Key.
+ * <<
+ * >> struct ID_art_node
+ *  Header of every inner node.
+ *
+ * @member
+ *  `type` - `ART_NODE4`, `ART_NODE16`, `ART_NODE48` or `ART_NODE256`.
+ *  `prefix_length` - Length of the prefix.
+ *  `count` - Number of children.
+ *  `prefix` - Bytes shared by all keys under the node.
+ *  `leaf` - Leaf of the key ending at the node, `NULL` if none.
+ * <<
+ * >> struct ID_art_node4, struct ID_art_node16
+ *
+ * @member
+ *  `node` - Header.
+ *  `keys` - Sorted key bytes of the children.
+ *  `children` - Children.
+ * <<
+ * >> struct ID_art_node48
+ *
+ * @member
+ *  `node` - Header.
+ *  `indexes` - Index plus one of the child of every key byte, 0 if none.
+ *  `children` - Children.
+ * <<
+ * >> struct ID_art_node256
+ *
+ * @member
+ *  `node` - Header.
+ *  `children` - Child of every key byte.
+ * <<
+ * >> struct ID_art
+ *
+ * @member
+ *  `root` - Root, a node or a leaf.
+ *  `length` - Number of items.
+ *  `node4_pool`, `node16_pool`, `node48_pool`, `node256_pool` - Pools of the
+ *  nodes.
+ * <<
+ * A child is a pointer to either node or leaf, leaf is tagged by the lowest
+ * bit.
+ * */
+#define ART_DECLARE_STRUCT(mp_id, mp_keyword) \
+    mp_keyword struct mp_id ## _art_leaf; \
+    mp_keyword struct mp_id ## _art_node; \
+    mp_keyword struct mp_id ## _art_node4; \
+    mp_keyword struct mp_id ## _art_node16; \
+    mp_keyword struct mp_id ## _art_node48; \
+    mp_keyword struct mp_id ## _art_node256; \
+    POOL_DECLARE_STRUCT(mp_id ## _art_node4, mp_keyword) \
+    POOL_DECLARE_STRUCT(mp_id ## _art_node16, mp_keyword) \
+    POOL_DECLARE_STRUCT(mp_id ## _art_node48, mp_keyword) \
+    POOL_DECLARE_STRUCT(mp_id ## _art_node256, mp_keyword) \
+    mp_keyword struct mp_id ## _art;
+
+#define ART_DEFINE_STRUCT(mp_id, mp_type, mp_keyword) \
+    typedef bool (*mp_id ## _art_callback)(const uint8_t* p_key, list_uint p_length, mp_type p_item, void* p_context); \
+    mp_keyword struct mp_id ## _art_leaf { \
+        mp_type item; \
+        list_uint length; \
+        uint8_t key[]; \
+    }; \
+    mp_keyword struct mp_id ## _art_node { \
+        uint8_t type; \
+        uint8_t prefix_length; \
+        uint16_t count; \
+        uint8_t prefix[ART_PREFIX_LENGTH]; \
+        struct mp_id ## _art_leaf* leaf; \
+    }; \
+    mp_keyword struct mp_id ## _art_node4 { \
+        struct mp_id ## _art_node node; \
+        uint8_t keys[4]; \
+        struct mp_id ## _art_node* children[4]; \
+    }; \
+    mp_keyword struct mp_id ## _art_node16 { \
+        struct mp_id ## _art_node node; \
+        uint8_t keys[16]; \
+        struct mp_id ## _art_node* children[16]; \
+    }; \
+    mp_keyword struct mp_id ## _art_node48 { \
+        struct mp_id ## _art_node node; \
+        uint8_t indexes[256]; \
+        struct mp_id ## _art_node* children[48]; \
+    }; \
+    mp_keyword struct mp_id ## _art_node256 { \
+        struct mp_id ## _art_node node; \
+        struct mp_id ## _art_node* children[256]; \
+    }; \
+    POOL_DEFINE_STRUCT(mp_id ## _art_node4, struct mp_id ## _art_node4, mp_keyword); \
+    POOL_DEFINE_STRUCT(mp_id ## _art_node16, struct mp_id ## _art_node16, mp_keyword); \
+    POOL_DEFINE_STRUCT(mp_id ## _art_node48, struct mp_id ## _art_node48, mp_keyword); \
+    POOL_DEFINE_STRUCT(mp_id ## _art_node256, struct mp_id ## _art_node256, mp_keyword); \
+    mp_keyword struct mp_id ## _art { \
+        struct mp_id ## _art_node* root; \
+        list_uint length; \
+        struct mp_id ## _art_node4_pool node4_pool; \
+        struct mp_id ## _art_node16_pool node16_pool; \
+        struct mp_id ## _art_node48_pool node48_pool; \
+        struct mp_id ## _art_node256_pool node256_pool; \
+    }
+
+/* # Functions
+ * >> ID_art_free_items
+ *  Free every item & node of the tree.
+ *
+ * @param
+ *  `p_art` - The tree to be operated.
+ *
+ * @noreturn
+ *
+ * @noerror
+ * <<
+ * >> ID_art_length
+ *
+ * @param
+ *  `p_art` - The tree to be operated on.
+ *
+ * @return
+ *  % - Number of items in the tree.
+ *
+ * @noerror
+ * <<
+ * >> ID_art_get
+ *  Get the item of a key.
+ *
+ * @param
+ *  `p_art` - The tree to be operated on.
+ *  `p_key` - Key.
+ *  `p_length` - Length of the key.
+ *
+ * @return
+ *  `r_item` - Item of the key. Optional.
+ *  % - Whether the key is in the tree.
+ *
+ * @noerror
+ * <<
+ * >> ID_art_insert
+ *  Insert an item by key, replacing the item if the key is in the tree.
+ *
+ * @param
+ *  `p_art` - The tree to be operated.
+ *  `p_key` - Key, copied into the tree.
+ *  `p_length` - Length of the key.
+ *  `p_item` - Item.
+ *
+ * @return
+ *  `r_is_new` - Whether the key was not in the tree. Optional.
+ *
+ * @error
+ *  | When fail to allocate a node or leaf, it fails. The tree stays valid
+ *  | without the key.
+ *  % - `true` on success. `false` on fail.
+ * <<
+ * >> ID_art_erase
+ *  Erase the item of a key.
+ *
+ * @param
+ *  `p_art` - The tree to be operated.
+ *  `p_key` - Key.
+ *  `p_length` - Length of the key.
+ *
+ * @return
+ *  `r_item` - Erased item. Optional.
+ *  % - Whether the key was in the tree.
+ *
+ * @noerror
+ * <<
+ * >> ID_art_each_prefix
+ *  Visit the items whose key starts with the prefix, in key order.
+ *
+ * @param
+ *  `p_art` - The tree to be operated on.
+ *  `p_prefix` - Prefix, empty for every item.
+ *  `p_length` - Length of the prefix.
+ *  `p_callback` - Callback of every item.
+ *  `p_context` - Passed to the callback.
+ *
+ * @return
+ *  % - Number of visited items.
+ *
+ * @noerror
+ * <<
+ * >> ID_art_each_range
+ *  Visit the items whose key is not less than the low key and less than the
+ *  high key, in key order.
+ *
+ * @param
+ *  `p_art` - The tree to be operated on.
+ *  `p_low` - Low key, `NULL` for no low bound.
+ *  `p_low_length` - Length of the low key.
+ *  `p_high` - High key, `NULL` for no high bound.
+ *  `p_high_length` - Length of the high key.
+ *  `p_callback` - Callback of every item.
+ *  `p_context` - Passed to the callback.
+ *
+ * @return
+ *  % - Number of visited items.
+ *
+ * @noerror
+ * <<
+ * */
+#define ART_DECLARE_FUNCTION(mp_id, mp_type, mp_keyword) \
+    mp_keyword void mp_id ## _art_free_items(struct mp_id ## _art* p_art); \
+    mp_keyword list_uint mp_id ## _art_length(const struct mp_id ## _art* p_art); \
+    mp_keyword bool mp_id ## _art_get(const struct mp_id ## _art* p_art, const uint8_t* p_key, list_uint p_length, mp_type* r_item); \
+    mp_keyword bool mp_id ## _art_insert(struct mp_id ## _art* p_art, const uint8_t* p_key, list_uint p_length, const mp_type p_item, bool* r_is_new); \
+    mp_keyword bool mp_id ## _art_erase(struct mp_id ## _art* p_art, const uint8_t* p_key, list_uint p_length, mp_type* r_item); \
+    mp_keyword list_uint mp_id ## _art_each_prefix(const struct mp_id ## _art* p_art, const uint8_t* p_prefix, list_uint p_length, bool (*p_callback)(const uint8_t* p_key, list_uint p_length, mp_type p_item, void* p_context), void* p_context); \
+    mp_keyword list_uint mp_id ## _art_each_range(const struct mp_id ## _art* p_art, const uint8_t* p_low, list_uint p_low_length, const uint8_t* p_high, list_uint p_high_length, bool (*p_callback)(const uint8_t* p_key, list_uint p_length, mp_type p_item, void* p_context), void* p_context);
+
+#define ART_DEFINE_FUNCTION(mp_id, mp_type, mp_keyword) \
+    POOL_DEFINE_FUNCTION(mp_id ## _art_node4, struct mp_id ## _art_node4, static inline) \
+    POOL_DEFINE_FUNCTION(mp_id ## _art_node16, struct mp_id ## _art_node16, static inline) \
+    POOL_DEFINE_FUNCTION(mp_id ## _art_node48, struct mp_id ## _art_node48, static inline) \
+    POOL_DEFINE_FUNCTION(mp_id ## _art_node256, struct mp_id ## _art_node256, static inline) \
+    static bool mp_id ## _art_is_leaf(const struct mp_id ## _art_node* p_node) { \
+        return (uintptr_t)p_node & 1; \
+    } \
+    static struct mp_id ## _art_leaf* mp_id ## _art_leaf_of(const struct mp_id ## _art_node* p_node) { \
+        return (struct mp_id ## _art_leaf*)((uintptr_t)p_node - 1); \
+    } \
+    static struct mp_id ## _art_node* mp_id ## _art_tag(const struct mp_id ## _art_leaf* p_leaf) { \
+        return (struct mp_id ## _art_node*)((uintptr_t)p_leaf + 1); \
+    } \
+    static struct mp_id ## _art_leaf* mp_id ## _art_leaf_new(const uint8_t* p_key, list_uint p_length, const mp_type p_item) { \
+        struct mp_id ## _art_leaf* leaf = LIST_CALLOC(1, sizeof(struct mp_id ## _art_leaf) + p_length); \
+        if(!leaf) return NULL; \
+        leaf->item = p_item; \
+        leaf->length = p_length; \
+        if(p_length) memcpy(leaf->key, p_key, p_length); \
+        return leaf; \
+    } \
+    static bool mp_id ## _art_leaf_match(const struct mp_id ## _art_leaf* p_leaf, const uint8_t* p_key, list_uint p_length) { \
+        return p_leaf->length == p_length && (!p_length || !memcmp(p_leaf->key, p_key, p_length)); \
+    } \
+    static struct mp_id ## _art_node* mp_id ## _art_node_new(struct mp_id ## _art* p_art, uint8_t p_type) { \
+        struct mp_id ## _art_node* node = NULL; \
+        size_t size = 0; \
+        switch(p_type) { \
+            case ART_NODE4: \
+                node = (struct mp_id ## _art_node*)mp_id ## _art_node4_pool_alloc(&p_art->node4_pool); \
+                size = sizeof(struct mp_id ## _art_node4); \
+                break; \
+            case ART_NODE16: \
+                node = (struct mp_id ## _art_node*)mp_id ## _art_node16_pool_alloc(&p_art->node16_pool); \
+                size = sizeof(struct mp_id ## _art_node16); \
+                break; \
+            case ART_NODE48: \
+                node = (struct mp_id ## _art_node*)mp_id ## _art_node48_pool_alloc(&p_art->node48_pool); \
+                size = sizeof(struct mp_id ## _art_node48); \
+                break; \
+            default: \
+                node = (struct mp_id ## _art_node*)mp_id ## _art_node256_pool_alloc(&p_art->node256_pool); \
+                size = sizeof(struct mp_id ## _art_node256); \
+                break; \
+        } \
+        if(!node) return NULL; \
+        memset(node, 0, size); \
+        node->type = p_type; \
+        return node; \
+    } \
+    static void mp_id ## _art_node_release(struct mp_id ## _art* p_art, struct mp_id ## _art_node* p_node) { \
+        switch(p_node->type) { \
+            case ART_NODE4: mp_id ## _art_node4_pool_release(&p_art->node4_pool, (struct mp_id ## _art_node4*)p_node); break; \
+            case ART_NODE16: mp_id ## _art_node16_pool_release(&p_art->node16_pool, (struct mp_id ## _art_node16*)p_node); break; \
+            case ART_NODE48: mp_id ## _art_node48_pool_release(&p_art->node48_pool, (struct mp_id ## _art_node48*)p_node); break; \
+            default: mp_id ## _art_node256_pool_release(&p_art->node256_pool, (struct mp_id ## _art_node256*)p_node); break; \
+        } \
+    } \
+    /* Sorted keys & children of node4 or node16. */ \
+    static void mp_id ## _art_sorted(struct mp_id ## _art_node* p_node, uint8_t** r_keys, struct mp_id ## _art_node*** r_children) { \
+        if(p_node->type == ART_NODE4) { \
+            *r_keys = ((struct mp_id ## _art_node4*)p_node)->keys; \
+            *r_children = ((struct mp_id ## _art_node4*)p_node)->children; \
+        } else { \
+            *r_keys = ((struct mp_id ## _art_node16*)p_node)->keys; \
+            *r_children = ((struct mp_id ## _art_node16*)p_node)->children; \
+        } \
+    } \
+    /* Slot of the child of a key byte, `NULL` if none. */ \
+    static struct mp_id ## _art_node** mp_id ## _art_child(struct mp_id ## _art_node* p_node, uint8_t p_byte) { \
+        switch(p_node->type) { \
+            case ART_NODE4: { \
+                struct mp_id ## _art_node4* node = (struct mp_id ## _art_node4*)p_node; \
+                for(uint16_t i = 0; i < p_node->count; i++) if(node->keys[i] == p_byte) return node->children + i; \
+                return NULL; \
+            } \
+            case ART_NODE16: { \
+                struct mp_id ## _art_node16* node = (struct mp_id ## _art_node16*)p_node; \
+                const int index = art_node16_find(node->keys, p_node->count, p_byte); \
+                return index < 0? NULL: node->children + index; \
+            } \
+            case ART_NODE48: { \
+                struct mp_id ## _art_node48* node = (struct mp_id ## _art_node48*)p_node; \
+                return node->indexes[p_byte]? node->children + node->indexes[p_byte] - 1: NULL; \
+            } \
+            default: { \
+                struct mp_id ## _art_node256* node = (struct mp_id ## _art_node256*)p_node; \
+                return node->children[p_byte]? node->children + p_byte: NULL; \
+            } \
+        } \
+    } \
+    /* Next child in key order from `p_position`, which starts at 0; `NULL` at the end. */ \
+    static struct mp_id ## _art_node* mp_id ## _art_next(struct mp_id ## _art_node* p_node, uint16_t* p_position, uint8_t* r_byte) { \
+        switch(p_node->type) { \
+            case ART_NODE4: \
+            case ART_NODE16: { \
+                if(*p_position >= p_node->count) return NULL; \
+                uint8_t* keys = NULL; \
+                struct mp_id ## _art_node** children = NULL; \
+                mp_id ## _art_sorted(p_node, &keys, &children); \
+                *r_byte = keys[*p_position]; \
+                return children[(*p_position)++]; \
+            } \
+            case ART_NODE48: { \
+                struct mp_id ## _art_node48* node = (struct mp_id ## _art_node48*)p_node; \
+                for(; *p_position < 256; (*p_position)++) { \
+                    if(!node->indexes[*p_position]) continue; \
+                    *r_byte = (uint8_t)*p_position; \
+                    return node->children[node->indexes[(*p_position)++] - 1]; \
+                } \
+                return NULL; \
+            } \
+            default: { \
+                struct mp_id ## _art_node256* node = (struct mp_id ## _art_node256*)p_node; \
+                for(; *p_position < 256; (*p_position)++) { \
+                    if(!node->children[*p_position]) continue; \
+                    *r_byte = (uint8_t)*p_position; \
+                    return node->children[(*p_position)++]; \
+                } \
+                return NULL; \
+            } \
+        } \
+    } \
+    /* Number of prefix bytes of the node matching the key from `p_depth`. */ \
+    static list_uint mp_id ## _art_prefix_match(const struct mp_id ## _art_node* p_node, const uint8_t* p_key, list_uint p_length, list_uint p_depth) { \
+        list_uint i = 0; \
+        while(i < p_node->prefix_length && p_depth + i < p_length && p_node->prefix[i] == p_key[p_depth + i]) i++; \
+        return i; \
+    } \
+    /* Replace the node in the slot by the next larger one. */ \
+    static bool mp_id ## _art_grow(struct mp_id ## _art* p_art, struct mp_id ## _art_node** p_slot) { \
+        struct mp_id ## _art_node* node = *p_slot; \
+        struct mp_id ## _art_node* grown = mp_id ## _art_node_new(p_art, node->type + 1); \
+        if(!grown) return false; \
+        *grown = *node; \
+        grown->type = node->type + 1; \
+        switch(node->type) { \
+            case ART_NODE4: { \
+                struct mp_id ## _art_node4* old = (struct mp_id ## _art_node4*)node; \
+                struct mp_id ## _art_node16* new = (struct mp_id ## _art_node16*)grown; \
+                memcpy(new->keys, old->keys, node->count); \
+                memcpy(new->children, old->children, node->count * sizeof(struct mp_id ## _art_node*)); \
+                break; \
+            } \
+            case ART_NODE16: { \
+                struct mp_id ## _art_node16* old = (struct mp_id ## _art_node16*)node; \
+                struct mp_id ## _art_node48* new = (struct mp_id ## _art_node48*)grown; \
+                for(uint16_t i = 0; i < node->count; i++) { \
+                    new->indexes[old->keys[i]] = (uint8_t)(i + 1); \
+                    new->children[i] = old->children[i]; \
+                } \
+                break; \
+            } \
+            default: { \
+                struct mp_id ## _art_node48* old = (struct mp_id ## _art_node48*)node; \
+                struct mp_id ## _art_node256* new = (struct mp_id ## _art_node256*)grown; \
+                for(uint16_t byte = 0; byte < 256; byte++) \
+                    if(old->indexes[byte]) new->children[byte] = old->children[old->indexes[byte] - 1]; \
+                break; \
+            } \
+        } \
+        mp_id ## _art_node_release(p_art, node); \
+        *p_slot = grown; \
+        return true; \
+    } \
+    /* Replace the node in the slot by the next smaller one. On fail the node is kept as is. */ \
+    static void mp_id ## _art_shrink(struct mp_id ## _art* p_art, struct mp_id ## _art_node** p_slot) { \
+        struct mp_id ## _art_node* node = *p_slot; \
+        struct mp_id ## _art_node* shrunk = mp_id ## _art_node_new(p_art, node->type - 1); \
+        if(!shrunk) return; \
+        *shrunk = *node; \
+        shrunk->type = node->type - 1; \
+        uint16_t count = 0; \
+        switch(node->type) { \
+            case ART_NODE16: { \
+                struct mp_id ## _art_node16* old = (struct mp_id ## _art_node16*)node; \
+                struct mp_id ## _art_node4* new = (struct mp_id ## _art_node4*)shrunk; \
+                memcpy(new->keys, old->keys, node->count); \
+                memcpy(new->children, old->children, node->count * sizeof(struct mp_id ## _art_node*)); \
+                break; \
+            } \
+            case ART_NODE48: { \
+                struct mp_id ## _art_node48* old = (struct mp_id ## _art_node48*)node; \
+                struct mp_id ## _art_node16* new = (struct mp_id ## _art_node16*)shrunk; \
+                for(uint16_t byte = 0; byte < 256; byte++) { \
+                    if(!old->indexes[byte]) continue; \
+                    new->keys[count] = (uint8_t)byte; \
+                    new->children[count++] = old->children[old->indexes[byte] - 1]; \
+                } \
+                break; \
+            } \
+            default: { \
+                struct mp_id ## _art_node256* old = (struct mp_id ## _art_node256*)node; \
+                struct mp_id ## _art_node48* new = (struct mp_id ## _art_node48*)shrunk; \
+                for(uint16_t byte = 0; byte < 256; byte++) { \
+                    if(!old->children[byte]) continue; \
+                    new->children[count] = old->children[byte]; \
+                    new->indexes[byte] = (uint8_t)++count; \
+                } \
+                break; \
+            } \
+        } \
+        mp_id ## _art_node_release(p_art, node); \
+        *p_slot = shrunk; \
+    } \
+    /* Add a child of a key byte not in the node, growing the node when full. */ \
+    static bool mp_id ## _art_add_child(struct mp_id ## _art* p_art, struct mp_id ## _art_node** p_slot, uint8_t p_byte, struct mp_id ## _art_node* p_child) { \
+        struct mp_id ## _art_node* node = *p_slot; \
+        const uint16_t capacity = node->type == ART_NODE4? 4: node->type == ART_NODE16? 16: node->type == ART_NODE48? 48: 256; \
+        if(node->count == capacity) { \
+            if(!mp_id ## _art_grow(p_art, p_slot)) return false; \
+            node = *p_slot; \
+        } \
+        switch(node->type) { \
+            case ART_NODE4: \
+            case ART_NODE16: { \
+                uint8_t* keys = NULL; \
+                struct mp_id ## _art_node** children = NULL; \
+                mp_id ## _art_sorted(node, &keys, &children); \
+                const uint16_t index = art_lower_bound(keys, node->count, p_byte); \
+                memmove(keys + index + 1, keys + index, node->count - index); \
+                memmove(children + index + 1, children + index, (node->count - index) * sizeof(struct mp_id ## _art_node*)); \
+                keys[index] = p_byte; \
+                children[index] = p_child; \
+                break; \
+            } \
+            case ART_NODE48: { \
+                struct mp_id ## _art_node48* node48 = (struct mp_id ## _art_node48*)node; \
+                uint8_t slot = 0; \
+                while(node48->children[slot]) slot++; \
+                node48->children[slot] = p_child; \
+                node48->indexes[p_byte] = slot + 1; \
+                break; \
+            } \
+            default: \
+                ((struct mp_id ## _art_node256*)node)->children[p_byte] = p_child; \
+                break; \
+        } \
+        node->count++; \
+        return true; \
+    } \
+    /* Remove the child of a key byte in the node, shrinking the node when sparse. */ \
+    static void mp_id ## _art_remove_child(struct mp_id ## _art* p_art, struct mp_id ## _art_node** p_slot, uint8_t p_byte) { \
+        struct mp_id ## _art_node* node = *p_slot; \
+        switch(node->type) { \
+            case ART_NODE4: \
+            case ART_NODE16: { \
+                uint8_t* keys = NULL; \
+                struct mp_id ## _art_node** children = NULL; \
+                mp_id ## _art_sorted(node, &keys, &children); \
+                const uint16_t index = art_lower_bound(keys, node->count, p_byte); \
+                memmove(keys + index, keys + index + 1, node->count - index - 1); \
+                memmove(children + index, children + index + 1, (node->count - index - 1) * sizeof(struct mp_id ## _art_node*)); \
+                break; \
+            } \
+            case ART_NODE48: { \
+                struct mp_id ## _art_node48* node48 = (struct mp_id ## _art_node48*)node; \
+                node48->children[node48->indexes[p_byte] - 1] = NULL; \
+                node48->indexes[p_byte] = 0; \
+                break; \
+            } \
+            default: \
+                ((struct mp_id ## _art_node256*)node)->children[p_byte] = NULL; \
+                break; \
+        } \
+        node->count--; \
+        /* Shrink below the size of the next smaller node, so a node doesn't flip at the boundary. */ \
+        if((node->type == ART_NODE16 && node->count <= 3) || (node->type == ART_NODE48 && node->count <= 12) || (node->type == ART_NODE256 && node->count <= 37)) \
+            mp_id ## _art_shrink(p_art, p_slot); \
+    } \
+    /* Replace a node left with no child, or a node4 left with one child and no leaf, by its only content. */ \
+    static void mp_id ## _art_collapse(struct mp_id ## _art* p_art, struct mp_id ## _art_node** p_slot) { \
+        struct mp_id ## _art_node* node = *p_slot; \
+        if(!node->count) { \
+            *p_slot = node->leaf? mp_id ## _art_tag(node->leaf): NULL; \
+            mp_id ## _art_node_release(p_art, node); \
+            return; \
+        } \
+        if(node->type != ART_NODE4 || node->count > 1 || node->leaf) return; \
+        struct mp_id ## _art_node4* node4 = (struct mp_id ## _art_node4*)node; \
+        struct mp_id ## _art_node* child = node4->children[0]; \
+        if(!mp_id ## _art_is_leaf(child)) { \
+            if(node->prefix_length + 1 + child->prefix_length > ART_PREFIX_LENGTH) return; \
+            memmove(child->prefix + node->prefix_length + 1, child->prefix, child->prefix_length); \
+            memcpy(child->prefix, node->prefix, node->prefix_length); \
+            child->prefix[node->prefix_length] = node4->keys[0]; \
+            child->prefix_length += node->prefix_length + 1; \
+        } \
+        *p_slot = child; \
+        mp_id ## _art_node_release(p_art, node); \
+    } \
+    static void mp_id ## _art_free_leaves(struct mp_id ## _art_node* p_node) { \
+        if(mp_id ## _art_is_leaf(p_node)) { \
+            LIST_FREE(mp_id ## _art_leaf_of(p_node)); \
+            return; \
+        } \
+        if(p_node->leaf) LIST_FREE(p_node->leaf); \
+        uint16_t position = 0; \
+        uint8_t byte = 0; \
+        for(struct mp_id ## _art_node* child; (child = mp_id ## _art_next(p_node, &position, &byte));) mp_id ## _art_free_leaves(child); \
+    } \
+    mp_keyword void mp_id ## _art_free_items(struct mp_id ## _art* p_art) { \
+        if(p_art->root) mp_id ## _art_free_leaves(p_art->root); \
+        mp_id ## _art_node4_pool_free_items(&p_art->node4_pool); \
+        mp_id ## _art_node16_pool_free_items(&p_art->node16_pool); \
+        mp_id ## _art_node48_pool_free_items(&p_art->node48_pool); \
+        mp_id ## _art_node256_pool_free_items(&p_art->node256_pool); \
+        p_art->root = NULL; \
+        p_art->length = 0; \
+    } \
+    mp_keyword list_uint mp_id ## _art_length(const struct mp_id ## _art* p_art) { \
+        return p_art->length; \
+    } \
+    mp_keyword bool mp_id ## _art_get(const struct mp_id ## _art* p_art, const uint8_t* p_key, list_uint p_length, mp_type* r_item) { \
+        struct mp_id ## _art_node* node = p_art->root; \
+        struct mp_id ## _art_leaf* leaf = NULL; \
+        list_uint depth = 0; \
+        while(node) { \
+            if(mp_id ## _art_is_leaf(node)) { \
+                leaf = mp_id ## _art_leaf_of(node); \
+                if(!mp_id ## _art_leaf_match(leaf, p_key, p_length)) return false; \
+                break; \
+            } \
+            if(mp_id ## _art_prefix_match(node, p_key, p_length, depth) != node->prefix_length) return false; \
+            depth += node->prefix_length; \
+            if(depth == p_length) { \
+                leaf = node->leaf; \
+                break; \
+            } \
+            struct mp_id ## _art_node** child = mp_id ## _art_child(node, p_key[depth++]); \
+            if(!child) return false; \
+            node = *child; \
+        } \
+        if(!leaf) return false; \
+        if(r_item) *r_item = leaf->item; \
+        return true; \
+    } \
+    mp_keyword bool mp_id ## _art_insert(struct mp_id ## _art* p_art, const uint8_t* p_key, list_uint p_length, const mp_type p_item, bool* r_is_new) { \
+        struct mp_id ## _art_node** slot = &p_art->root; \
+        list_uint depth = 0; \
+        for(;;) { \
+            struct mp_id ## _art_node* node = *slot; \
+            if(!node) { \
+                struct mp_id ## _art_leaf* leaf = mp_id ## _art_leaf_new(p_key, p_length, p_item); \
+                if(!leaf) return false; \
+                *slot = mp_id ## _art_tag(leaf); \
+                break; \
+            } \
+            if(mp_id ## _art_is_leaf(node)) { \
+                struct mp_id ## _art_leaf* leaf = mp_id ## _art_leaf_of(node); \
+                if(mp_id ## _art_leaf_match(leaf, p_key, p_length)) { \
+                    leaf->item = p_item; \
+                    if(r_is_new) *r_is_new = false; \
+                    return true; \
+                } \
+                /* Split the leaf by a node over the bytes both keys share, the new key is put in by the next round. */ \
+                list_uint common = 0; \
+                while(common < ART_PREFIX_LENGTH && depth + common < leaf->length && depth + common < p_length && leaf->key[depth + common] == p_key[depth + common]) common++; \
+                struct mp_id ## _art_node* split = mp_id ## _art_node_new(p_art, ART_NODE4); \
+                if(!split) return false; \
+                split->prefix_length = (uint8_t)common; \
+                memcpy(split->prefix, p_key + depth, common); \
+                if(depth + common == leaf->length) split->leaf = leaf; \
+                else mp_id ## _art_add_child(p_art, &split, leaf->key[depth + common], node); \
+                *slot = split; \
+                continue; \
+            } \
+            const list_uint match = mp_id ## _art_prefix_match(node, p_key, p_length, depth); \
+            if(match < node->prefix_length) { \
+                /* Split the prefix at the first mismatch. */ \
+                struct mp_id ## _art_node* split = mp_id ## _art_node_new(p_art, ART_NODE4); \
+                if(!split) return false; \
+                split->prefix_length = (uint8_t)match; \
+                memcpy(split->prefix, node->prefix, match); \
+                const uint8_t byte = node->prefix[match]; \
+                node->prefix_length -= match + 1; \
+                memmove(node->prefix, node->prefix + match + 1, node->prefix_length); \
+                mp_id ## _art_add_child(p_art, &split, byte, node); \
+                *slot = split; \
+                continue; \
+            } \
+            depth += node->prefix_length; \
+            if(depth == p_length) { \
+                if(node->leaf) { \
+                    node->leaf->item = p_item; \
+                    if(r_is_new) *r_is_new = false; \
+                    return true; \
+                } \
+                node->leaf = mp_id ## _art_leaf_new(p_key, p_length, p_item); \
+                if(!node->leaf) return false; \
+                break; \
+            } \
+            struct mp_id ## _art_node** child = mp_id ## _art_child(node, p_key[depth]); \
+            if(child) { \
+                slot = child; \
+                depth++; \
+                continue; \
+            } \
+            struct mp_id ## _art_leaf* leaf = mp_id ## _art_leaf_new(p_key, p_length, p_item); \
+            if(!leaf) return false; \
+            if(!mp_id ## _art_add_child(p_art, slot, p_key[depth], mp_id ## _art_tag(leaf))) { \
+                LIST_FREE(leaf); \
+                return false; \
+            } \
+            break; \
+        } \
+        p_art->length++; \
+        if(r_is_new) *r_is_new = true; \
+        return true; \
+    } \
+    /* Erase the key under the node in the slot, the slot is left `NULL` if nothing remains under it. */ \
+    static bool mp_id ## _art_erase_at(struct mp_id ## _art* p_art, struct mp_id ## _art_node** p_slot, const uint8_t* p_key, list_uint p_length, list_uint p_depth, mp_type* r_item) { \
+        struct mp_id ## _art_node* node = *p_slot; \
+        if(mp_id ## _art_is_leaf(node)) { \
+            struct mp_id ## _art_leaf* leaf = mp_id ## _art_leaf_of(node); \
+            if(!mp_id ## _art_leaf_match(leaf, p_key, p_length)) return false; \
+            if(r_item) *r_item = leaf->item; \
+            LIST_FREE(leaf); \
+            *p_slot = NULL; \
+            return true; \
+        } \
+        if(mp_id ## _art_prefix_match(node, p_key, p_length, p_depth) != node->prefix_length) return false; \
+        p_depth += node->prefix_length; \
+        if(p_depth == p_length) { \
+            if(!node->leaf) return false; \
+            if(r_item) *r_item = node->leaf->item; \
+            LIST_FREE(node->leaf); \
+            node->leaf = NULL; \
+        } else { \
+            struct mp_id ## _art_node** child = mp_id ## _art_child(node, p_key[p_depth]); \
+            if(!child || !mp_id ## _art_erase_at(p_art, child, p_key, p_length, p_depth + 1, r_item)) return false; \
+            if(!*child) mp_id ## _art_remove_child(p_art, p_slot, p_key[p_depth]); \
+        } \
+        mp_id ## _art_collapse(p_art, p_slot); \
+        return true; \
+    } \
+    mp_keyword bool mp_id ## _art_erase(struct mp_id ## _art* p_art, const uint8_t* p_key, list_uint p_length, mp_type* r_item) { \
+        if(!p_art->root || !mp_id ## _art_erase_at(p_art, &p_art->root, p_key, p_length, 0, r_item)) return false; \
+        p_art->length--; \
+        return true; \
+    } \
+    /* Visit every item under the node in key order, `false` once the callback stops. */ \
+    static bool mp_id ## _art_visit(struct mp_id ## _art_node* p_node, mp_id ## _art_callback p_callback, void* p_context, list_uint* r_count) { \
+        if(mp_id ## _art_is_leaf(p_node)) { \
+            const struct mp_id ## _art_leaf* leaf = mp_id ## _art_leaf_of(p_node); \
+            (*r_count)++; \
+            return p_callback(leaf->key, leaf->length, leaf->item, p_context); \
+        } \
+        if(p_node->leaf) { \
+            (*r_count)++; \
+            if(!p_callback(p_node->leaf->key, p_node->leaf->length, p_node->leaf->item, p_context)) return false; \
+        } \
+        uint16_t position = 0; \
+        uint8_t byte = 0; \
+        for(struct mp_id ## _art_node* child; (child = mp_id ## _art_next(p_node, &position, &byte));) \
+            if(!mp_id ## _art_visit(child, p_callback, p_context, r_count)) return false; \
+        return true; \
+    } \
+    /* Visit the items under the node within the range in key order, `false` once the callback stops or the high key is passed. \
+     * The path to the node equals the bounds up to `p_depth`, a bound is `NULL` once the path is past it. */ \
+    static bool mp_id ## _art_visit_range(struct mp_id ## _art_node* p_node, list_uint p_depth, const uint8_t* p_low, list_uint p_low_length, const uint8_t* p_high, list_uint p_high_length, mp_id ## _art_callback p_callback, void* p_context, list_uint* r_count) { \
+        if(!p_low && !p_high) return mp_id ## _art_visit(p_node, p_callback, p_context, r_count); \
+        if(mp_id ## _art_is_leaf(p_node)) { \
+            const struct mp_id ## _art_leaf* leaf = mp_id ## _art_leaf_of(p_node); \
+            if(p_low && art_compare(leaf->key, leaf->length, p_low, p_low_length) < 0) return true; \
+            if(p_high && art_compare(leaf->key, leaf->length, p_high, p_high_length) >= 0) return false; \
+            (*r_count)++; \
+            return p_callback(leaf->key, leaf->length, leaf->item, p_context); \
+        } \
+        for(uint8_t i = 0; i < p_node->prefix_length; i++, p_depth++) { \
+            const uint8_t byte = p_node->prefix[i]; \
+            if(p_low) { \
+                if(p_depth >= p_low_length || byte > p_low[p_depth]) p_low = NULL; \
+                else if(byte < p_low[p_depth]) return true; \
+            } \
+            if(p_high) { \
+                if(p_depth >= p_high_length || byte > p_high[p_depth]) return false; \
+                if(byte < p_high[p_depth]) p_high = NULL; \
+            } \
+        } \
+        if(p_high && p_depth >= p_high_length) return false; \
+        if(p_node->leaf && (!p_low || p_depth >= p_low_length)) { \
+            (*r_count)++; \
+            if(!p_callback(p_node->leaf->key, p_node->leaf->length, p_node->leaf->item, p_context)) return false; \
+        } \
+        if(p_low && p_depth >= p_low_length) p_low = NULL; \
+        uint16_t position = 0; \
+        uint8_t byte = 0; \
+        for(struct mp_id ## _art_node* child; (child = mp_id ## _art_next(p_node, &position, &byte));) { \
+            const uint8_t* low = p_low; \
+            const uint8_t* high = p_high; \
+            if(low) { \
+                if(byte < low[p_depth]) continue; \
+                if(byte > low[p_depth]) low = NULL; \
+            } \
+            if(high) { \
+                if(byte > high[p_depth]) return false; \
+                if(byte < high[p_depth]) high = NULL; \
+            } \
+            if(!mp_id ## _art_visit_range(child, p_depth + 1, low, p_low_length, high, p_high_length, p_callback, p_context, r_count)) return false; \
+        } \
+        return true; \
+    } \
+    mp_keyword list_uint mp_id ## _art_each_prefix(const struct mp_id ## _art* p_art, const uint8_t* p_prefix, list_uint p_length, mp_id ## _art_callback p_callback, void* p_context) { \
+        struct mp_id ## _art_node* node = p_art->root; \
+        list_uint count = 0; \
+        list_uint depth = 0; \
+        while(node) { \
+            if(mp_id ## _art_is_leaf(node)) { \
+                const struct mp_id ## _art_leaf* leaf = mp_id ## _art_leaf_of(node); \
+                if(leaf->length >= p_length && (!p_length || !memcmp(leaf->key, p_prefix, p_length))) { \
+                    count++; \
+                    p_callback(leaf->key, leaf->length, leaf->item, p_context); \
+                } \
+                break; \
+            } \
+            const list_uint match = mp_id ## _art_prefix_match(node, p_prefix, p_length, depth); \
+            if(match < node->prefix_length && depth + match < p_length) break; \
+            depth += node->prefix_length; \
+            if(depth >= p_length) { \
+                mp_id ## _art_visit(node, p_callback, p_context, &count); \
+                break; \
+            } \
+            struct mp_id ## _art_node** child = mp_id ## _art_child(node, p_prefix[depth++]); \
+            if(!child) break; \
+            node = *child; \
+        } \
+        return count; \
+    } \
+    mp_keyword list_uint mp_id ## _art_each_range(const struct mp_id ## _art* p_art, const uint8_t* p_low, list_uint p_low_length, const uint8_t* p_high, list_uint p_high_length, mp_id ## _art_callback p_callback, void* p_context) { \
+        list_uint count = 0; \
+        if(p_art->root) mp_id ## _art_visit_range(p_art->root, 0, p_low, p_low_length, p_high, p_high_length, p_callback, p_context, &count); \
+        return count; \
+    }
+
+/* Declare & define both structure and functions of tree, `mp_keyword` only
+ * applies to the functions. */
+#define ART_DECLARE(mp_id, mp_type, mp_keyword) \
+    ART_DECLARE_STRUCT(mp_id, ) \
+    ART_DECLARE_FUNCTION(mp_id, mp_type, mp_keyword)
+
+#define ART_DEFINE(mp_id, mp_type, mp_keyword) \
+    ART_DEFINE_STRUCT(mp_id, mp_type, ); \
+    ART_DEFINE_FUNCTION(mp_id, mp_type, mp_keyword)
+
+#endif //_ART_H_
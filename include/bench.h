@@ -0,0 +1,288 @@
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+/* # bench
+ * This file contains a small set of function for benchmarks, the timing
+ * counterpart of `test.h`. To start a benchmark run, `bench_start` must be
+ * called first before any other function. Then, use `bench` function to
+ * measure. After measuring, call `bench_end` to finalize the run, which either
+ * records the results as baseline or compares them against the baseline.
+ *
+ * ## Statistics
+ * Each benchmark is calibrated first: the function is repeated until one
+ * sample lasts at least `BENCH_MIN_SAMPLE_TIME` nanoseconds, so timer
+ * resolution and scheduler noise stay small against the sample. Then it is
+ * sampled `BENCH_SAMPLE_COUNT` times. The median time per operation is
+ * reported together with a 95% confidence interval of the median (order
+ * statistics, distribution free). A benchmark regresses when its median
+ * exceeds the baseline median by more than its tolerance AND its interval no
+ * longer overlaps the baseline interval, so noise alone rarely trips it.
+ *
+ * ## Allocation
+ * Allocations are counted through `bench_calloc`, `bench_realloc` and
+ * `bench_free`. Route the structure under benchmark through them, e.g. for
+ * list:
+ *  #define LIST_CALLOC bench_calloc
+ *  #define LIST_REALLOC bench_realloc
+ *  #define LIST_FREE bench_free
+ *  #include <list.h>
+ * Allocation per operation is deterministic, so any increase over the baseline
+ * is reported as regression even when timing is noisy.
+ *
+ * ## Baseline file
+ * One benchmark per line: `name median low high allocation`, with time in
+ * nanoseconds per operation and allocation in count per operation. The
+ * baseline is only written in record mode. Comparing without a baseline, or
+ * with a baseline benchmark missing from the run, fails. */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+typedef uint32_t bench_uint;
+
+#ifndef BENCH_SAMPLE_COUNT
+#define BENCH_SAMPLE_COUNT 21
+#endif //BENCH_SAMPLE_COUNT
+
+/* Minimum duration of a sample in nanoseconds. */
+#ifndef BENCH_MIN_SAMPLE_TIME
+#define BENCH_MIN_SAMPLE_TIME 1e7
+#endif //BENCH_MIN_SAMPLE_TIME
+
+#ifndef BENCH_MAX_COUNT
+#define BENCH_MAX_COUNT 64
+#endif //BENCH_MAX_COUNT
+
+#define BENCH_NAME_LENGTH 64
+
+struct bench_result {
+    char name[BENCH_NAME_LENGTH];
+    double median;
+    double low;
+    double high;
+    double allocation;
+    double tolerance;
+};
+
+static struct {
+    bool is_benching;
+    bool is_recording;
+    const char* baseline_path;
+    uint64_t allocation;
+    bench_uint total;
+    struct bench_result results[BENCH_MAX_COUNT];
+} bench_data = {0};
+
+/* Counting allocators.
+ *  Drop-in replacements of `calloc`, `realloc` and `free` that count the
+ *  allocation into `bench_data`. `realloc` counts as an allocation, as it may
+ *  move the memory.
+ * */
+static void* bench_calloc(size_t p_count, size_t p_size) {
+    bench_data.allocation++;
+    return calloc(p_count, p_size);
+}
+
+static void* bench_realloc(void* p_pointer, size_t p_size) {
+    bench_data.allocation++;
+    return realloc(p_pointer, p_size);
+}
+
+static void bench_free(void* p_pointer) {
+    free(p_pointer);
+}
+
+static double bench_now() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+static int bench_compare_double(const void* p_a, const void* p_b) {
+    const double a = *(const double*)p_a;
+    const double b = *(const double*)p_b;
+    return (a > b) - (a < b);
+}
+
+/* Start a benchmark run.
+ *  It initiate `bench_data` struct and print the `p_title`, signaling the
+ *  starting of benchmark.
+ *
+ * @param
+ *  `p_title` - Title of the benchmark that will be displayed onto screen.
+ *  `p_baseline_path` - Path of the baseline file.
+ *  `p_is_recording` - `true` records the results as baseline, `false` compares
+ *  the results against baseline.
+ *
+ * @noreturn
+ *
+ * @noerror */
+static void bench_start(const char* p_title, const char* p_baseline_path, bool p_is_recording) {
+    if(bench_data.is_benching) return;
+    printf("--%s--\n", p_title);
+    bench_data.baseline_path = p_baseline_path;
+    bench_data.is_recording = p_is_recording;
+    bench_data.total = 0;
+    bench_data.is_benching = true;
+}
+
+/* Measure an operation.
+ *  It runs `p_function` to warm up and to calibrate the number of runs per
+ *  sample, so a sample lasts at least `BENCH_MIN_SAMPLE_TIME`. Then it takes
+ *  `BENCH_SAMPLE_COUNT` samples and stores the statistics of time and
+ *  allocation per operation.
+ *
+ * @param
+ *  `p_name` - Name of the benchmark, unique and without whitespace.
+ *  `p_function` - Function that performs `p_count` operations.
+ *  `p_count` - Number of operations per sample.
+ *  `p_tolerance` - Allowed slow down ratio of median (e.g. `0.1` for 10%).
+ *
+ * @noreturn
+ *
+ * @noerror */
+static void bench(const char* p_name, void (*p_function)(bench_uint p_count), bench_uint p_count, double p_tolerance) {
+    if(!bench_data.is_benching || bench_data.total >= BENCH_MAX_COUNT) return;
+    double samples[BENCH_SAMPLE_COUNT];
+    struct bench_result* result = bench_data.results + bench_data.total++;
+    bench_uint repeat = 1;
+    for(;;) {
+        const double start = bench_now();
+        for(bench_uint i = 0; i < repeat; i++) p_function(p_count);
+        if(bench_now() - start >= BENCH_MIN_SAMPLE_TIME || repeat >= UINT32_MAX / 2) break;
+        repeat *= 2;
+    }
+    bench_data.allocation = 0;
+    for(bench_uint i = 0; i < BENCH_SAMPLE_COUNT; i++) {
+        const double start = bench_now();
+        for(bench_uint j = 0; j < repeat; j++) p_function(p_count);
+        samples[i] = (bench_now() - start) / ((double)p_count * repeat);
+    }
+    qsort(samples, BENCH_SAMPLE_COUNT, sizeof(double), bench_compare_double);
+
+    /* Ranks of 95% confidence interval of the median: median -+ 1.96 * sqrt(n)/2,
+     * symmetric around the median rank. */
+    const long middle = BENCH_SAMPLE_COUNT / 2;
+    const long spread = (long)ceil(0.98 * sqrt(BENCH_SAMPLE_COUNT));
+    const long low = middle - spread < 0? 0: middle - spread;
+    const long high = middle + spread > BENCH_SAMPLE_COUNT - 1? BENCH_SAMPLE_COUNT - 1: middle + spread;
+
+    snprintf(result->name, BENCH_NAME_LENGTH, "%s", p_name);
+    result->median = samples[middle];
+    result->low = samples[low];
+    result->high = samples[high];
+    result->allocation = (double)bench_data.allocation / ((double)p_count * repeat * BENCH_SAMPLE_COUNT);
+    result->tolerance = p_tolerance;
+    printf("[-] %-32s %12.2f ns/op [%.2f, %.2f] %8.4f alloc/op\n",
+            result->name, result->median, result->low, result->high, result->allocation);
+}
+
+/* Record the results to the baseline file.
+ *
+ * @noparam
+ *
+ * @noreturn
+ *
+ * @error
+ *  | When the baseline file can't be written, it fails.
+ *  % - `true` on success. `false` on fail. */
+static bool bench_record() {
+    FILE* file = fopen(bench_data.baseline_path, "w");
+    if(!file) return false;
+    for(bench_uint i = 0; i < bench_data.total; i++) {
+        const struct bench_result* result = bench_data.results + i;
+        fprintf(file, "%s %.4f %.4f %.4f %.6f\n",
+                result->name, result->median, result->low, result->high, result->allocation);
+    }
+    fclose(file);
+    printf("Baseline recorded to '%s'.\n", bench_data.baseline_path);
+    return true;
+}
+
+/* Compare the results against the baseline file and print the diff table.
+ *  Baseline benchmarks absent from the run are listed as missing.
+ *
+ * @param
+ *  `p_file` - Opened baseline file.
+ *
+ * @return
+ *  % - `true` when nothing regressed nor is missing, else `false`.
+ *
+ * @noerror */
+static bool bench_compare(FILE* p_file) {
+    struct bench_result baseline;
+    bench_uint regressed = 0;
+    printf("%-32s %12s %12s %8s %10s %10s  %s\n",
+            "benchmark", "base ns/op", "ns/op", "change", "base alloc", "alloc", "status");
+    for(bench_uint i = 0; i < bench_data.total; i++) {
+        const struct bench_result* result = bench_data.results + i;
+        bool is_found = false;
+        rewind(p_file);
+        while(fscanf(p_file, "%63s %lf %lf %lf %lf",
+                    baseline.name, &baseline.median, &baseline.low, &baseline.high, &baseline.allocation) == 5)
+            if(!strcmp(baseline.name, result->name)) { is_found = true; break; }
+        if(!is_found) {
+            printf("%-32s %12s %12.2f %8s %10s %10.4f  new\n",
+                    result->name, "-", result->median, "-", "-", result->allocation);
+            continue;
+        }
+        const bool is_slow = result->median > baseline.median * (1 + result->tolerance)
+            && result->low > baseline.high;
+        const bool is_allocating = result->allocation > baseline.allocation + 1e-6;
+        if(is_slow || is_allocating) regressed++;
+        printf("%-32s %12.2f %12.2f %+7.1f%% %10.4f %10.4f  %s%s%s\n",
+                result->name, baseline.median, result->median,
+                (result->median / baseline.median - 1) * 100,
+                baseline.allocation, result->allocation,
+                is_slow || is_allocating? "REGRESSED": "ok",
+                is_slow? " (time)": "", is_allocating? " (alloc)": "");
+    }
+    bench_uint missing = 0;
+    rewind(p_file);
+    while(fscanf(p_file, "%63s %lf %lf %lf %lf",
+                baseline.name, &baseline.median, &baseline.low, &baseline.high, &baseline.allocation) == 5) {
+        bool is_found = false;
+        for(bench_uint i = 0; i < bench_data.total && !is_found; i++)
+            is_found = !strcmp(baseline.name, bench_data.results[i].name);
+        if(is_found) continue;
+        missing++;
+        printf("%-32s %12.2f %12s %8s %10.4f %10s  MISSING\n",
+                baseline.name, baseline.median, "-", "-", baseline.allocation, "-");
+    }
+    printf("-----\nTotal benchmark: %u\nTotal regressed: %u\nTotal missing: %u\n", bench_data.total, regressed, missing);
+    return !regressed && !missing;
+}
+
+/* Finish benchmark run.
+ *  It ends the run and either records the baseline or compares against it.
+ *
+ * @noparam
+ *
+ * @return
+ *  % - `true` when recorded, or nothing regressed nor is missing, else
+ *  `false`.
+ *
+ * @error
+ *  | When comparing without a baseline file, it fails.
+ *  | When recording and the baseline file can't be written, it fails.
+ *  % - `false`. */
+static bool bench_end() {
+    if(!bench_data.is_benching) return true;
+    bench_data.is_benching = false;
+    if(bench_data.is_recording) return bench_record();
+    FILE* file = fopen(bench_data.baseline_path, "r");
+    if(!file) {
+        printf("No baseline at '%s', record one with `make bench_baseline`.\n", bench_data.baseline_path);
+        return false;
+    }
+    const bool result = bench_compare(file);
+    fclose(file);
+    return result;
+}
+
+#endif //_BENCH_H_
@@ -0,0 +1,204 @@
+#ifndef _BLOOM_H_
+#define _BLOOM_H_
+
+/* # bloom
+ * This file contains blocked bloom filter of 64-bit hashes. It answers "maybe
+ * in" or "definitely not in", so it rejects definite misses before hitting a
+ * slower structure, e.g. `set.h`:
+ *  const uint64_t hash = set_hash_integer(item);
+ *  if(bloom_contains(&bloom, hash) && int_set_contains(&set, item)) ...
+ *
+ * ## Layout
+ * The filter is an array of blocks of `BLOOM_BLOCK_LENGTH` bytes, the size of
+ * a cache line. The high bits of the hash pick the block and the low bits
+ * pick the bits within the block, so every query touches one cache line. The
+ * bits are the top bits of the low 32 bits of the hash, remixed by a
+ * multiplication after each pick.
+ *
+ * ## Sizing
+ * Confining the bits of an item to one block raises the false positive rate
+ * over a classic bloom filter, as the blocks load unevenly. `bloom_init`
+ * starts from the classic size and grows the block count until the rate,
+ * estimated over the Poisson distribution of items per block, meets the
+ * requested one.
+ *
+ * ## Memory
+ * Initialize the filter with `bloom_init` and free it with `bloom_free`. The
+ * blocks are aligned to cache line with `aligned_alloc`, so they don't go
+ * through the allocator of `list.h`. */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "list.h"
+
+#define BLOOM_BLOCK_LENGTH 64
+#define BLOOM_BLOCK_BITS (BLOOM_BLOCK_LENGTH * 8)
+#define BLOOM_BLOCK_WORDS (BLOOM_BLOCK_LENGTH / sizeof(uint64_t))
+/* Shift of the 32-bit remixed hash down to a bit of the block, 512 bits. */
+#define BLOOM_BIT_SHIFT (32 - 9)
+#define BLOOM_REMIX 0x9E3779B9u
+#define BLOOM_MAX_HASH_COUNT 16
+#define BLOOM_LN2 0.69314718055994530942
+
+/* False positive rate of blocks loaded with `p_load` items on average. */
+static inline double bloom_false_positive_rate(double p_load, uint8_t p_hash_count) {
+    const double spread = 10 * sqrt(p_load) + 10;
+    const double first = p_load > spread? floor(p_load - spread): 0;
+    double rate = 0;
+    for(double load = first; load <= p_load + spread; load++) {
+        const double chance = exp(load * log(p_load) - p_load - lgamma(load + 1));
+        const double bit = 1 - pow(1 - 1.0 / BLOOM_BLOCK_BITS, p_hash_count * load);
+        rate += chance * pow(bit, p_hash_count);
+    }
+    return rate;
+}
+
+/* # bloom structure
+ * >> struct bloom
+ *
+ * @member
+ *  `block_count` - Number of blocks.
+ *  `hash_count` - Number of bits set per item.
+ *  `words` - Array of blocks.
+ * <<
+ * */
+struct bloom {
+    list_uint block_count;
+    uint8_t hash_count;
+    uint64_t* words;
+};
+
+/* Initialize bloom filter.
+ *  It sizes the filter for the number of items and false positive rate.
+ *
+ * @param
+ *  `p_count` - Expected number of items.
+ *  `p_rate` - Expected false positive rate, between 0 and 1 exclusive.
+ *
+ * @return
+ *  `r_bloom` - Bloom filter to be initialized, zeroed on fail.
+ *
+ * @error
+ *  | When the rate is not between 0 and 1 exclusive, it fails.
+ *  | When the blocks are beyond `list_uint`, it fails.
+ *  | When fail to allocate the blocks, it fails.
+ *  % - `true` on success. `false` on fail. */
+static inline bool bloom_init(struct bloom* r_bloom, list_uint p_count, double p_rate) {
+    *r_bloom = (struct bloom){0};
+    if(!(p_rate > 0 && p_rate < 1)) return false;
+    const double count = p_count? p_count: 1;
+    const double bits_per_item = -log(p_rate) / (BLOOM_LN2 * BLOOM_LN2);
+    const double hash_count = round(bits_per_item * BLOOM_LN2);
+    const uint8_t hashes = hash_count < 1? 1: hash_count > BLOOM_MAX_HASH_COUNT? BLOOM_MAX_HASH_COUNT: (uint8_t)hash_count;
+    double block_count = ceil(bits_per_item * count / BLOOM_BLOCK_BITS);
+    while(block_count <= UINT32_MAX && bloom_false_positive_rate(count / block_count, hashes) > p_rate)
+        block_count += ceil(block_count / 32);
+    if(block_count > UINT32_MAX) return false;
+    r_bloom->block_count = (list_uint)block_count;
+    r_bloom->hash_count = hashes;
+    r_bloom->words = aligned_alloc(BLOOM_BLOCK_LENGTH, (size_t)r_bloom->block_count * BLOOM_BLOCK_LENGTH);
+    if(!r_bloom->words) return false;
+    memset(r_bloom->words, 0, (size_t)r_bloom->block_count * BLOOM_BLOCK_LENGTH);
+    return true;
+}
+
+/* Free bloom filter.
+ *
+ * @param
+ *  `p_bloom` - Bloom filter to be freed.
+ *
+ * @noreturn
+ *
+ * @noerror */
+static inline void bloom_free(struct bloom* p_bloom) {
+    free(p_bloom->words);
+}
+
+/* Block of the hash, picked by the high 32 bits without modulo. */
+static inline uint64_t* bloom_block(const struct bloom* p_bloom, uint64_t p_hash) {
+    return p_bloom->words + ((p_hash >> 32) * p_bloom->block_count >> 32) * BLOOM_BLOCK_WORDS;
+}
+
+/* Insert a hash.
+ *
+ * @param
+ *  `p_bloom` - Bloom filter to be operated.
+ *  `p_hash` - Hash of the item.
+ *
+ * @noreturn
+ *
+ * @noerror */
+static inline void bloom_insert(struct bloom* p_bloom, uint64_t p_hash) {
+    uint64_t* block = bloom_block(p_bloom, p_hash);
+    uint32_t remix = (uint32_t)p_hash;
+    for(uint8_t i = 0; i < p_bloom->hash_count; i++, remix *= BLOOM_REMIX) {
+        const uint32_t bit = remix >> BLOOM_BIT_SHIFT;
+        block[bit / 64] |= (uint64_t)1 << (bit % 64);
+    }
+}
+
+/* Check a hash.
+ *
+ * @param
+ *  `p_bloom` - Bloom filter to be operated on.
+ *  `p_hash` - Hash of the item.
+ *
+ * @return
+ *  % - `false` if the item is definitely not inserted, else `true`.
+ *
+ * @noerror */
+static inline bool bloom_contains(const struct bloom* p_bloom, uint64_t p_hash) {
+    const uint64_t* block = bloom_block(p_bloom, p_hash);
+    uint32_t remix = (uint32_t)p_hash;
+    for(uint8_t i = 0; i < p_bloom->hash_count; i++, remix *= BLOOM_REMIX) {
+        const uint32_t bit = remix >> BLOOM_BIT_SHIFT;
+        if(!(block[bit / 64] & ((uint64_t)1 << (bit % 64)))) return false;
+    }
+    return true;
+}
+
+/* Insert an array of hashes, prefetching the blocks ahead.
+ *
+ * @param
+ *  `p_bloom` - Bloom filter to be operated.
+ *  `p_hashes` - Array of hashes.
+ *  `p_length` - Length of the array.
+ *
+ * @noreturn
+ *
+ * @noerror */
+static inline void bloom_insert_array(struct bloom* p_bloom, const uint64_t* p_hashes, list_uint p_length) {
+    for(list_uint i = 0; i < p_length; i++) {
+        if(i + 8 < p_length) LIST_PREFETCH(bloom_block(p_bloom, p_hashes[i + 8]));
+        bloom_insert(p_bloom, p_hashes[i]);
+    }
+}
+
+/* Check an array of hashes, prefetching the blocks ahead.
+ *
+ * @param
+ *  `p_bloom` - Bloom filter to be operated on.
+ *  `p_hashes` - Array of hashes.
+ *  `p_length` - Length of the array.
+ *
+ * @return
+ *  `r_results` - Array of `p_length`, result of `bloom_contains` for each
+ *  hash. Optional.
+ *  % - Number of hashes that may be inserted.
+ *
+ * @noerror */
+static inline list_uint bloom_contains_array(const struct bloom* p_bloom, const uint64_t* p_hashes, list_uint p_length, bool* r_results) {
+    list_uint found = 0;
+    for(list_uint i = 0; i < p_length; i++) {
+        if(i + 8 < p_length) LIST_PREFETCH(bloom_block(p_bloom, p_hashes[i + 8]));
+        const bool result = bloom_contains(p_bloom, p_hashes[i]);
+        found += result;
+        if(r_results) r_results[i] = result;
+    }
+    return found;
+}
+
+#endif //_BLOOM_H_
@@ -0,0 +1,414 @@
+#ifndef _CONCURRENT_LIST_H_
+#define _CONCURRENT_LIST_H_
+
+/* # concurrent_list
+ * This file contains macro for declaring and defining append-only list that
+ * many threads append to without lock.
+ *
+ * ## Usage
+ * 1. Declare & define the concurrent list with the macros, `mp_id`, `mp_type`
+ * and `mp_keyword` mean the same as in `list.h`.
+ * 2. Initialize it on stack (`struct ID_concurrent_list list = {0};`) or heap
+ * (`ID_concurrent_list_new`).
+ * 3. Let the writers append (`ID_concurrent_list_append`,
+ * `ID_concurrent_list_append_array`), or reserve slots, write them and commit
+ * (`ID_concurrent_list_reserve`, `ID_concurrent_list_slot`,
+ * `ID_concurrent_list_commit`).
+ * 4. When the writers are done, seal it with `ID_concurrent_list_seal`. Only
+ * then it is readable, per segment (`ID_concurrent_list_segment`) or
+ * contiguous as a regular list (`ID_concurrent_list_to_list`, defined by
+ * `CONCURRENT_LIST_DEFINE_CONVERTER`).
+ * 5. Free it with `ID_concurrent_list_free_items` or `ID_concurrent_list_free`.
+ *
+ * ## Segment
+ * Writers reserve slots with an atomic fetch-and-add on `reserved`, so
+ * reserving is wait-free, and write them without lock. `reserved` is 64 bits
+ * wide, so it can't wrap before a reservation beyond `list_uint` is rejected
+ * and rolled back. `reserved` and `committed` sit on cache lines of their
+ * own, so writers bumping one don't invalidate the other. The items are
+ * stored in a chain of segments, segment `n` holds
+ * `CONCURRENT_LIST_SEGMENT_LENGTH << n` items, so a slot never moves once
+ * reserved. A missing segment is allocated by the first writer that needs it
+ * and published with compare-and-swap.
+ *
+ * ## Memory
+ * Segments are allocated through `LIST_CALLOC` and `LIST_FREE` of `list.h`,
+ * which must be thread safe. The structure of `ID_concurrent_list_new` is
+ * aligned to cache line with `aligned_alloc`, so it doesn't go through them.
+ * Allocation failure while appending leaves reserved slots that never commit,
+ * so the list can't be sealed anymore and should be discarded.
+ *
+ * ## Ordering
+ * Commit publishes the written slots with release, seal acquires them and
+ * publishes `is_sealed` with release, and readers acquire `is_sealed`, so a
+ * reader that sees the list sealed sees every committed slot. */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "list.h"
+
+/* Length of the first segment, must be a power of 2. */
+#ifndef CONCURRENT_LIST_SEGMENT_LENGTH
+#define CONCURRENT_LIST_SEGMENT_LENGTH 64
+#endif //CONCURRENT_LIST_SEGMENT_LENGTH
+
+/* Size of cache line, the alignment of the counters. */
+#ifndef CONCURRENT_LIST_CACHE_LINE
+#define CONCURRENT_LIST_CACHE_LINE 64
+#endif //CONCURRENT_LIST_CACHE_LINE
+
+/* Enough segments to address every `list_uint` index. */
+#define CONCURRENT_LIST_SEGMENT_COUNT 32
+
+/* Locate the segment and the offset in the segment of an index. */
+static inline list_uint concurrent_list_locate(list_uint p_index, list_uint* r_offset) {
+    const uint64_t position = (uint64_t)p_index + CONCURRENT_LIST_SEGMENT_LENGTH;
+#if defined(__GNUC__) || defined(__clang__)
+    const list_uint top = 63 - __builtin_clzll(position);
+    const list_uint base = __builtin_ctz(CONCURRENT_LIST_SEGMENT_LENGTH);
+#else
+    list_uint top = 0, base = 0;
+    while(position >> (top + 1)) top++;
+    while(!((CONCURRENT_LIST_SEGMENT_LENGTH >> base) & 1)) base++;
+#endif
+    const list_uint segment = top - base;
+    *r_offset = (list_uint)(position - ((uint64_t)CONCURRENT_LIST_SEGMENT_LENGTH << segment));
+    return segment;
+}
+
+/* # concurrent list structure
+ * >> struct ID_concurrent_list
+ *
+ * @member
+ *  `reserved` - Number of reserved slots.
+ *  `committed` - Number of written slots.
+ *  `is_sealed` - Whether the list is sealed and readable.
+ *  `segments` - Chain of segments, `NULL` when not allocated yet.
+ * <<
+ * */
+#define CONCURRENT_LIST_DECLARE_STRUCT(mp_id, mp_keyword) \
+    mp_keyword struct mp_id ## _concurrent_list;
+
+#define CONCURRENT_LIST_DEFINE_STRUCT(mp_id, mp_type, mp_keyword) \
+    mp_keyword struct mp_id ## _concurrent_list { \
+        _Alignas(CONCURRENT_LIST_CACHE_LINE) _Atomic(uint64_t) reserved; \
+        _Alignas(CONCURRENT_LIST_CACHE_LINE) _Atomic(list_uint) committed; \
+        _Alignas(CONCURRENT_LIST_CACHE_LINE) _Atomic(bool) is_sealed; \
+        _Atomic(mp_type*) segments[CONCURRENT_LIST_SEGMENT_COUNT]; \
+    }
+
+/* # Writer functions
+ * These functions are thread safe before the list is sealed.
+ *
+ * >> ID_concurrent_list_new
+ *  Allocate memory for the concurrent list structure.
+ *
+ * @noparam
+ *
+ * @return
+ *  % - Pointer to the allocated concurrent list structure.
+ *
+ * @error
+ *  | When the allocator function fails, it fails.
+ *  % - Valid pointer on success. `NULL` on fail.
+ * <<
+ * >> ID_concurrent_list_reserve
+ *  Reserve consecutive slots and allocate the segments they fall in. The slots
+ *  must be written with `ID_concurrent_list_slot` and then committed.
+ *
+ * @param
+ *  `p_list` - The concurrent list to be operated.
+ *  `p_count` - Number of slots.
+ *
+ * @return
+ *  `r_index` - Index of the first reserved slot.
+ *
+ * @error
+ *  | When the list is sealed, it fails.
+ *  | When the slots are beyond `list_uint`, it fails and nothing is reserved.
+ *  A reservation racing with such failure may fail as well.
+ *  | When fail to allocate a segment, it fails.
+ *  % - `true` on success. `false` on fail.
+ * <<
+ * >> ID_concurrent_list_slot
+ *  Get the reserved slot by index. Slots of consecutive indexes are
+ *  contiguous until the end of the segment, see `ID_concurrent_list_segment`.
+ *
+ * @param
+ *  `p_list` - The concurrent list to be operated.
+ *  `p_index` - Index of a reserved slot.
+ *
+ * @return
+ *  % - Pointer to the slot.
+ *
+ * @noerror
+ * <<
+ * >> ID_concurrent_list_commit
+ *  Mark reserved slots as written.
+ *
+ * @param
+ *  `p_list` - The concurrent list to be operated.
+ *  `p_count` - Number of written slots.
+ *
+ * @noreturn
+ *
+ * @noerror
+ * <<
+ * >> ID_concurrent_list_append
+ *  Reserve, write and commit an item.
+ *
+ * @param
+ *  `p_list` - The concurrent list to be operated.
+ *  `p_item` - New item.
+ *
+ * @noreturn
+ *
+ * @error
+ *  | When `ID_concurrent_list_reserve` fails, it fails.
+ *  % - `true` on success. `false` on fail.
+ * <<
+ * >> ID_concurrent_list_append_array
+ *  Reserve, write and commit the items of an array with one reservation, the
+ *  items stay consecutive.
+ *
+ * @param
+ *  `p_list` - The concurrent list to be operated.
+ *  `p_array` - Array of new items.
+ *  `p_length` - Length of the array.
+ *
+ * @noreturn
+ *
+ * @error
+ *  | When `ID_concurrent_list_reserve` fails, it fails.
+ *  % - `true` on success. `false` on fail.
+ * <<
+ * */
+#define CONCURRENT_LIST_DECLARE_WRITER(mp_id, mp_type, mp_keyword) \
+    mp_keyword struct mp_id ## _concurrent_list* mp_id ## _concurrent_list_new(); \
+    mp_keyword bool mp_id ## _concurrent_list_reserve(struct mp_id ## _concurrent_list* p_list, list_uint p_count, list_uint* r_index); \
+    mp_keyword mp_type* mp_id ## _concurrent_list_slot(struct mp_id ## _concurrent_list* p_list, list_uint p_index); \
+    mp_keyword void mp_id ## _concurrent_list_commit(struct mp_id ## _concurrent_list* p_list, list_uint p_count); \
+    mp_keyword bool mp_id ## _concurrent_list_append(struct mp_id ## _concurrent_list* p_list, const mp_type p_item); \
+    mp_keyword bool mp_id ## _concurrent_list_append_array(struct mp_id ## _concurrent_list* p_list, const mp_type* p_array, list_uint p_length);
+
+#define CONCURRENT_LIST_DEFINE_WRITER(mp_id, mp_type, mp_keyword) \
+    mp_keyword struct mp_id ## _concurrent_list* mp_id ## _concurrent_list_new() { \
+        struct mp_id ## _concurrent_list* list = aligned_alloc(CONCURRENT_LIST_CACHE_LINE, sizeof(struct mp_id ## _concurrent_list)); \
+        if(list) memset(list, 0, sizeof(struct mp_id ## _concurrent_list)); \
+        return list; \
+    } \
+    mp_keyword bool mp_id ## _concurrent_list_reserve(struct mp_id ## _concurrent_list* p_list, list_uint p_count, list_uint* r_index) { \
+        if(atomic_load_explicit(&p_list->is_sealed, memory_order_relaxed)) return false; \
+        const uint64_t index = atomic_fetch_add_explicit(&p_list->reserved, p_count, memory_order_relaxed); \
+        if(index + p_count > UINT32_MAX) { \
+            atomic_fetch_sub_explicit(&p_list->reserved, p_count, memory_order_relaxed); \
+            return false; \
+        } \
+        if(!p_count) { *r_index = (list_uint)index; return true; } \
+        list_uint offset = 0; \
+        const list_uint first = concurrent_list_locate((list_uint)index, &offset); \
+        const list_uint last = concurrent_list_locate((list_uint)(index + p_count - 1), &offset); \
+        for(list_uint i = first; i <= last; i++) { \
+            if(atomic_load_explicit(p_list->segments + i, memory_order_acquire)) continue; \
+            mp_type* expected = NULL; \
+            mp_type* segment = LIST_CALLOC((size_t)CONCURRENT_LIST_SEGMENT_LENGTH << i, sizeof(mp_type)); \
+            if(!segment) return false; \
+            if(!atomic_compare_exchange_strong_explicit(p_list->segments + i, &expected, segment, memory_order_acq_rel, memory_order_acquire)) \
+                LIST_FREE(segment); \
+        } \
+        *r_index = (list_uint)index; \
+        return true; \
+    } \
+    mp_keyword mp_type* mp_id ## _concurrent_list_slot(struct mp_id ## _concurrent_list* p_list, list_uint p_index) { \
+        list_uint offset = 0; \
+        const list_uint segment = concurrent_list_locate(p_index, &offset); \
+        return atomic_load_explicit(p_list->segments + segment, memory_order_acquire) + offset; \
+    } \
+    mp_keyword void mp_id ## _concurrent_list_commit(struct mp_id ## _concurrent_list* p_list, list_uint p_count) { \
+        atomic_fetch_add_explicit(&p_list->committed, p_count, memory_order_release); \
+    } \
+    mp_keyword bool mp_id ## _concurrent_list_append(struct mp_id ## _concurrent_list* p_list, const mp_type p_item) { \
+        list_uint index = 0; \
+        if(!mp_id ## _concurrent_list_reserve(p_list, 1, &index)) return false; \
+        *mp_id ## _concurrent_list_slot(p_list, index) = p_item; \
+        mp_id ## _concurrent_list_commit(p_list, 1); \
+        return true; \
+    } \
+    mp_keyword bool mp_id ## _concurrent_list_append_array(struct mp_id ## _concurrent_list* p_list, const mp_type* p_array, list_uint p_length) { \
+        list_uint index = 0; \
+        list_uint offset = 0; \
+        if(!mp_id ## _concurrent_list_reserve(p_list, p_length, &index)) return false; \
+        for(list_uint written = 0; written < p_length;) { \
+            const list_uint segment = concurrent_list_locate(index + written, &offset); \
+            uint64_t count = ((uint64_t)CONCURRENT_LIST_SEGMENT_LENGTH << segment) - offset; \
+            if(count > p_length - written) count = p_length - written; \
+            memcpy(mp_id ## _concurrent_list_slot(p_list, index + written), p_array + written, count * sizeof(mp_type)); \
+            written += (list_uint)count; \
+        } \
+        mp_id ## _concurrent_list_commit(p_list, p_length); \
+        return true; \
+    }
+
+/* # Reader functions
+ * These functions are NOT thread safe, call them when writers are done.
+ *
+ * >> ID_concurrent_list_free
+ *  Free the concurrent list structure together with the segments.
+ *
+ * @param
+ *  `p_list` - The concurrent list to be operated.
+ *
+ * @noreturn
+ *
+ * @noerror
+ * <<
+ * >> ID_concurrent_list_free_items
+ *  Free the segments of the concurrent list.
+ *
+ * @param
+ *  `p_list` - The concurrent list to be operated.
+ *
+ * @noreturn
+ *
+ * @noerror
+ * <<
+ * >> ID_concurrent_list_seal
+ *  Seal the list once every reserved slot is committed. A sealed list
+ *  doesn't accept writes anymore and is readable.
+ *
+ * @param
+ *  `p_list` - The concurrent list to be operated.
+ *
+ * @noreturn
+ *
+ * @error
+ *  | When some reserved slots are not committed yet, it fails.
+ *  % - `true` on success. `false` on fail.
+ * <<
+ * >> ID_concurrent_list_length
+ *  Get the length of the sealed list.
+ *
+ * @param
+ *  `p_list` - The concurrent list to be operated on.
+ *
+ * @return
+ *  % - Length of the list, 0 when not sealed.
+ *
+ * @noerror
+ * <<
+ * >> ID_concurrent_list_get
+ *  Get item of the sealed list by index.
+ *
+ * @param
+ *  `p_list` - The concurrent list to be operated on.
+ *  `p_index` - Index of item retreived.
+ *
+ * @return
+ *  `r_item` - Retreived item.
+ *
+ * @error
+ *  | When the list is not sealed, it fails.
+ *  | When index requested is out of range, it fails.
+ *  % - `true` on success. `false` on fail.
+ * <<
+ * >> ID_concurrent_list_segment
+ *  Get the items of a segment of the sealed list.
+ *
+ * @param
+ *  `p_list` - The concurrent list to be operated on.
+ *  `p_segment` - Index of segment.
+ *
+ * @return
+ *  `r_items` - Items of the segment.
+ *  `r_length` - Number of items in the segment.
+ *
+ * @error
+ *  | When the list is not sealed, it fails.
+ *  | When the segment is beyond the length, it fails.
+ *  % - `true` on success. `false` on fail.
+ * <<
+ * */
+#define CONCURRENT_LIST_DECLARE_READER(mp_id, mp_type, mp_keyword) \
+    mp_keyword void mp_id ## _concurrent_list_free(struct mp_id ## _concurrent_list* p_list); \
+    mp_keyword void mp_id ## _concurrent_list_free_items(struct mp_id ## _concurrent_list* p_list); \
+    mp_keyword bool mp_id ## _concurrent_list_seal(struct mp_id ## _concurrent_list* p_list); \
+    mp_keyword list_uint mp_id ## _concurrent_list_length(const struct mp_id ## _concurrent_list* p_list); \
+    mp_keyword bool mp_id ## _concurrent_list_get(struct mp_id ## _concurrent_list* p_list, list_uint p_index, mp_type* r_item); \
+    mp_keyword bool mp_id ## _concurrent_list_segment(struct mp_id ## _concurrent_list* p_list, list_uint p_segment, const mp_type** r_items, list_uint* r_length);
+
+#define CONCURRENT_LIST_DEFINE_READER(mp_id, mp_type, mp_keyword) \
+    mp_keyword void mp_id ## _concurrent_list_free_items(struct mp_id ## _concurrent_list* p_list) { \
+        for(list_uint i = 0; i < CONCURRENT_LIST_SEGMENT_COUNT; i++) { \
+            mp_type* segment = atomic_load_explicit(p_list->segments + i, memory_order_relaxed); \
+            if(segment) LIST_FREE(segment); \
+        } \
+    } \
+    mp_keyword void mp_id ## _concurrent_list_free(struct mp_id ## _concurrent_list* p_list) { \
+        mp_id ## _concurrent_list_free_items(p_list); \
+        free(p_list); \
+    } \
+    mp_keyword bool mp_id ## _concurrent_list_seal(struct mp_id ## _concurrent_list* p_list) { \
+        if(atomic_load_explicit(&p_list->is_sealed, memory_order_acquire)) return true; \
+        const list_uint committed = atomic_load_explicit(&p_list->committed, memory_order_acquire); \
+        if(committed != atomic_load_explicit(&p_list->reserved, memory_order_relaxed)) return false; \
+        atomic_store_explicit(&p_list->is_sealed, true, memory_order_release); \
+        return true; \
+    } \
+    mp_keyword list_uint mp_id ## _concurrent_list_length(const struct mp_id ## _concurrent_list* p_list) { \
+        return atomic_load_explicit(&p_list->is_sealed, memory_order_acquire)? atomic_load_explicit(&p_list->committed, memory_order_relaxed): 0; \
+    } \
+    mp_keyword bool mp_id ## _concurrent_list_get(struct mp_id ## _concurrent_list* p_list, list_uint p_index, mp_type* r_item) { \
+        if(p_index >= mp_id ## _concurrent_list_length(p_list)) return false; \
+        if(r_item) *r_item = *mp_id ## _concurrent_list_slot(p_list, p_index); \
+        return true; \
+    } \
+    mp_keyword bool mp_id ## _concurrent_list_segment(struct mp_id ## _concurrent_list* p_list, list_uint p_segment, const mp_type** r_items, list_uint* r_length) { \
+        const list_uint length = mp_id ## _concurrent_list_length(p_list); \
+        const uint64_t start = ((uint64_t)CONCURRENT_LIST_SEGMENT_LENGTH << p_segment) - CONCURRENT_LIST_SEGMENT_LENGTH; \
+        if(p_segment >= CONCURRENT_LIST_SEGMENT_COUNT || start >= length) return false; \
+        const uint64_t end = start + ((uint64_t)CONCURRENT_LIST_SEGMENT_LENGTH << p_segment); \
+        *r_items = atomic_load_explicit(p_list->segments + p_segment, memory_order_relaxed); \
+        *r_length = (list_uint)((end < length? end: length) - start); \
+        return true; \
+    }
+
+/* # Converter functions
+ * >> ID_concurrent_list_to_list
+ *  Copy the sealed concurrent list into a contiguous list, replacing its
+ *  items.
+ *
+ * @param
+ *  `p_list` - The concurrent list to be operated on.
+ *
+ * @return
+ *  `r_list` - Target list to be copied to.
+ *
+ * @error
+ *  | When the list is not sealed, it fails.
+ *  | When fail to allocate an array, it fails.
+ *  % - `true` on success. `false` on fail.
+ * <<
+ * */
+#define CONCURRENT_LIST_DECLARE_CONVERTER(mp_id, mp_list_id, mp_keyword) \
+    mp_keyword bool mp_id ## _concurrent_list_to_list(struct mp_id ## _concurrent_list* p_list, struct mp_list_id ## _list* r_list);
+
+#define CONCURRENT_LIST_DEFINE_CONVERTER(mp_id, mp_list_id, mp_keyword) \
+    mp_keyword bool mp_id ## _concurrent_list_to_list(struct mp_id ## _concurrent_list* p_list, struct mp_list_id ## _list* r_list) { \
+        if(!atomic_load_explicit(&p_list->is_sealed, memory_order_acquire)) return false; \
+        const list_uint length = mp_id ## _concurrent_list_length(p_list); \
+        if(!mp_list_id ## _list_reserve(r_list, length)) return false; \
+        list_uint copied = 0; \
+        for(list_uint i = 0; copied < length; i++) { \
+            uint64_t count = (uint64_t)CONCURRENT_LIST_SEGMENT_LENGTH << i; \
+            if(count > length - copied) count = length - copied; \
+            memcpy(r_list->items + copied, atomic_load_explicit(p_list->segments + i, memory_order_relaxed), count * sizeof(*r_list->items)); \
+            copied += (list_uint)count; \
+        } \
+        r_list->length = length; \
+        return true; \
+    }
+
+#endif //_CONCURRENT_LIST_H_
@@ -37,11 +37,24 @@
  * - Modify the member of the struct, unless you know want you are doing. 
  * - Free with `free` from stdlib instead of `ID_list_free`.
  * - Give NULL pointer as argument, all functions do not check the validity of
- *   pointer.*/
+ *   pointer.
+ *
+ * ## Allocator
+ * The list allocates through `LIST_CALLOC`, `LIST_REALLOC` and `LIST_FREE`,
+ * which default to the stdlib functions. Define them before including this
+ * file to route the allocation elsewhere (e.g. counting allocator of
+ * `bench.h`).
+ *
+ * The list structure of `ID_list_new` is allocated through
+ * `LIST_HEADER_ALLOC(mp_id)` and freed through
+ * `LIST_HEADER_FREE(mp_id, p_list)` by `ID_list_free`, which default to the
+ * allocator above. Define them before including this file to draw the list
+ * structures from an object pool (read `pool.h`).*/
 
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 
 typedef uint32_t list_uint;
 
@@ -49,6 +62,36 @@ typedef uint32_t list_uint;
 #define LIST_INIT_ITEM_COUNT 20
 #endif //LIST_INIT_ITEM_COUNT
 
+#ifndef LIST_CALLOC
+#define LIST_CALLOC calloc
+#endif //LIST_CALLOC
+
+#ifndef LIST_REALLOC
+#define LIST_REALLOC realloc
+#endif //LIST_REALLOC
+
+#ifndef LIST_FREE
+#define LIST_FREE free
+#endif //LIST_FREE
+
+#ifndef LIST_HEADER_ALLOC
+#define LIST_HEADER_ALLOC(mp_id) LIST_CALLOC(1, sizeof(struct mp_id ## _list))
+#endif //LIST_HEADER_ALLOC
+
+#ifndef LIST_HEADER_FREE
+#define LIST_HEADER_FREE(mp_id, mp_list) LIST_FREE(mp_list)
+#endif //LIST_HEADER_FREE
+
+/* Hint the CPU to fetch the memory pointed into cache, used by the batch
+ * functions of the containers. */
+#ifndef LIST_PREFETCH
+#if defined(__GNUC__) || defined(__clang__)
+#define LIST_PREFETCH(mp_pointer) __builtin_prefetch(mp_pointer)
+#else
+#define LIST_PREFETCH(mp_pointer) ((void)(mp_pointer))
+#endif
+#endif //LIST_PREFETCH
+
 /* # list structure 
  * >> struct ID_list 
  *
@@ -200,6 +243,20 @@ typedef uint32_t list_uint;
  *  | When fail to allocate an array, it fails.
  *  % - `true` on success. `false` on fail. 
  * <<
+ * >> ID_list_reserve
+ *  Make sure the list has at least `p_capacity` allocated slots, so that
+ *  filling it up to that length doesn't reallocate. 
+ *
+ * @param 
+ *  `p_list` - The list to be operated. 
+ *  `p_capacity` - Minimum number of slots. 
+ *
+ * @noreturn 
+ *
+ * @error
+ *  | When fail to allocate an array, it fails.
+ *  % - `true` on success. `false` on fail. 
+ * <<
  * >> ID_list_set
  *  Set item in the list by index. 
  *
@@ -226,6 +283,7 @@ typedef uint32_t list_uint;
  *
  * @error 
  *  | When the index is out of bound, it fails. 
+ *  | When the list already holds the maximum of `list_uint` items, it fails.
  *  | When fail to allocate an array, it fails.
  *  % - `true` on success. `false` on fail. 
  * <<
@@ -300,6 +358,7 @@ typedef uint32_t list_uint;
     mp_keyword void mp_id ## _list_free(struct mp_id ## _list* p_list); \
     mp_keyword void mp_id ## _list_free_items(struct mp_id ## _list* p_list); \
     mp_keyword bool mp_id ## _list_from_array(const mp_type* p_array, list_uint p_length, struct mp_id ## _list* r_list); \
+    mp_keyword bool mp_id ## _list_reserve(struct mp_id ## _list* p_list, list_uint p_capacity); \
     mp_keyword bool mp_id ## _list_set(struct mp_id ## _list* p_list, const mp_type p_item, list_uint p_index); \
     mp_keyword bool mp_id ## _list_insert(struct mp_id ## _list* p_list, const mp_type p_item, list_uint p_index); \
     mp_keyword bool mp_id ## _list_erase(struct mp_id ## _list* p_list, list_uint p_index); \
@@ -310,30 +369,40 @@ typedef uint32_t list_uint;
 
 #define LIST_DEFINE_SETTER(mp_id, mp_type, mp_keyword) \
     mp_keyword struct mp_id ## _list* mp_id ## _list_new() { \
-        return calloc(1, sizeof(struct mp_id ## _list)); \
+        struct mp_id ## _list* list = LIST_HEADER_ALLOC(mp_id); \
+        if(list) *list = (struct mp_id ## _list){0}; \
+        return list; \
     } \
     mp_keyword void mp_id ## _list_free(struct mp_id ## _list* p_list) { \
-        if(p_list->capacity) free(p_list->items);  \
-        free(p_list);  \
+        if(p_list->capacity) LIST_FREE(p_list->items);  \
+        LIST_HEADER_FREE(mp_id, p_list);  \
     } \
     mp_keyword void mp_id ## _list_free_items(struct mp_id ## _list* p_list) { \
-        if(p_list->capacity) free(p_list->items); \
+        if(p_list->capacity) LIST_FREE(p_list->items); \
     } \
-    static bool mp_id ## _list_make_space(struct mp_id ## _list* p_list, list_uint p_new_length) { \
-        list_uint new_capacity = p_list->capacity? p_list->capacity: LIST_INIT_ITEM_COUNT; \
+    static bool mp_id ## _list_make_space(struct mp_id ## _list* p_list, uint64_t p_new_length) { \
+        if(p_new_length <= p_list->capacity) return true; \
+        if(p_new_length > UINT32_MAX) return false; \
+        uint64_t new_capacity = p_list->capacity? p_list->capacity: LIST_INIT_ITEM_COUNT; \
         while(new_capacity < p_new_length) new_capacity *= 2;  \
+        if(new_capacity > UINT32_MAX) new_capacity = UINT32_MAX; \
+        if(new_capacity > SIZE_MAX / sizeof(mp_type)) return false; \
         mp_type* new_items = NULL; \
-        if(!(new_items = realloc(p_list->items, new_capacity * sizeof(mp_type)))) return false;  \
+        if(!(new_items = LIST_REALLOC(p_list->items, new_capacity * sizeof(mp_type)))) return false;  \
         p_list->items = new_items;  \
-        p_list->capacity = new_capacity;  \
+        p_list->capacity = (list_uint)new_capacity;  \
         return true; \
     } \
     mp_keyword bool mp_id ## _list_from_array(const mp_type* p_array, list_uint p_length, struct mp_id ## _list* r_list) { \
         if(!mp_id ## _list_make_space(r_list, p_length)) return false; \
-        memcpy(r_list->items, p_array, p_length * sizeof(mp_type));  \
+        if(p_length) memcpy(r_list->items, p_array, p_length * sizeof(mp_type));  \
         r_list->length = p_length;  \
         return true;  \
     } \
+    mp_keyword bool mp_id ## _list_reserve(struct mp_id ## _list* p_list, list_uint p_capacity) { \
+        if(p_capacity <= p_list->capacity) return true; \
+        return mp_id ## _list_make_space(p_list, p_capacity); \
+    } \
     mp_keyword bool mp_id ## _list_set(struct mp_id ## _list* p_list, const mp_type p_item, list_uint p_index) { \
         if(p_index >= p_list->length) return false;  \
         p_list->items[p_index] = p_item;  \
@@ -341,7 +410,7 @@ typedef uint32_t list_uint;
     } \
     mp_keyword bool mp_id ## _list_insert(struct mp_id ## _list* p_list, const mp_type p_item, list_uint p_index) { \
         if(p_index > p_list->length) return false;  \
-        if(!mp_id ## _list_make_space(p_list, p_list->length + 1)) return false; \
+        if(!mp_id ## _list_make_space(p_list, (uint64_t)p_list->length + 1)) return false; \
         for(list_uint i = p_list->length; i > p_index; i--) \
             memcpy(p_list->items + i, p_list->items + i - 1, sizeof(mp_type));   \
         p_list->items[p_index] = p_item; \
@@ -362,12 +431,14 @@ typedef uint32_t list_uint;
         return mp_id ## _list_insert(p_list, p_item, 0); \
     } \
     mp_keyword bool mp_id ## _list_pop_back(struct mp_id ## _list* p_list, mp_type* r_popped) { \
-        const mp_type popped = p_list->items[p_list->length];  \
+        if(!p_list->length) return false; \
+        const mp_type popped = p_list->items[p_list->length - 1];  \
         if(!mp_id ## _list_erase(p_list, p_list->length - 1)) return false; \
         *r_popped = popped;  \
         return true; \
     } \
     mp_keyword bool mp_id ## _list_pop_front(struct mp_id ## _list* p_list, mp_type* r_popped) { \
+        if(!p_list->length) return false; \
         const mp_type popped = p_list->items[0]; \
         if(!mp_id ## _list_erase(p_list, 0)) return false; \
         *r_popped = popped;  \
@@ -0,0 +1,40 @@
+#ifndef _LIST_COMMON_H_
+#define _LIST_COMMON_H_
+
+/* # list_common
+ * This file declares the lists of common primitive types that are precompiled
+ * into `libstruct` (`export/lib/libstruct.a` or `export/lib/libstruct.so`, built
+ * by `make lib`). Include this file and link with the library instead of
+ * expanding `LIST_DEFINE_GETTER` & `LIST_DEFINE_SETTER` in every translation
+ * unit.
+ *
+ * | ID       | Type       |
+ * | -------- | ---------- |
+ * | `int`    | `int`      |
+ * | `uint64` | `uint64_t` |
+ * | `double` | `double`   |
+ * | `ptr`    | `list_ptr` |
+ *
+ * e.g. `struct uint64_list`, `uint64_list_append`, etc. 
+ *
+ * `list_ptr` is `void*` behind a typedef, as the macros prefix the type with
+ * `const` and `const void*` would constify the pointee instead. 
+ *
+ * Lists of other types are still instantiated header-only with `list.h`, just
+ * don't reuse the IDs above. */
+
+#include "list.h"
+
+typedef void* list_ptr;
+
+#define LIST_COMMON_DECLARE(mp_id, mp_type) \
+    LIST_DEFINE_STRUCT(mp_id, mp_type, ); \
+    LIST_DECLARE_GETTER(mp_id, mp_type, ) \
+    LIST_DECLARE_SETTER(mp_id, mp_type, )
+
+LIST_COMMON_DECLARE(int, int)
+LIST_COMMON_DECLARE(uint64, uint64_t)
+LIST_COMMON_DECLARE(double, double)
+LIST_COMMON_DECLARE(ptr, list_ptr)
+
+#endif //_LIST_COMMON_H_
@@ -0,0 +1,445 @@
+#ifndef _PACKED_LIST_H_
+#define _PACKED_LIST_H_
+
+/* # packed_list
+ * This file contains macro for declaring and defining compressed list of
+ * sorted unsigned integers (e.g. `uint32_t`, `uint64_t`). It is append-only
+ * and the items must be appended in non-decreasing order, as in a list of
+ * sorted IDs.
+ *
+ * ## Usage
+ * Same as `list.h`: declare & define the packed list with the macros, then
+ * initialize it on stack (`struct ID_packed_list list = {0};`) or heap
+ * (`ID_packed_list_new`), and free it with `ID_packed_list_free_items` or
+ * `ID_packed_list_free` respectively. `mp_id`, `mp_type` and `mp_keyword` mean
+ * the same as in `list.h`.
+ *
+ * `PACKED_LIST_DEFINE_CONVERTER` additionally defines decoding into a regular
+ * list of the same item type, `mp_list_id` is the ID of that list.
+ *
+ * ## Encoding
+ * Items are grouped in blocks of `PACKED_LIST_BLOCK_LENGTH`. Each block stores
+ * the delta to the previous item, bit-packed with the smallest width that fits
+ * the largest delta in the block, so a block of `n` items with width `w` takes
+ * `n * w / 64` words. The first item, the width and the word offset of every
+ * block are kept in a skip array, which is binary searched to seek.
+ * Unpacking is a branch-free loop over fixed width. With SSE2 it unpacks two
+ * items per step, item `i` and item `i + 64`, which sit at the same bit shift
+ * `w` words apart, so both share one shift instruction (or a portable loop).
+ *
+ * The items that don't fill a block yet stay raw in `tail` until the block is
+ * full, so appending is amortized O(1).
+ *
+ * ## Memory
+ * Allocation goes through `LIST_CALLOC`, `LIST_REALLOC` and `LIST_FREE` of
+ * `list.h`. As for list, don't modify the members or give NULL pointer. */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "list.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/* Must be a multiple of 64, so every block ends at a word boundary. */
+#ifndef PACKED_LIST_BLOCK_LENGTH
+#define PACKED_LIST_BLOCK_LENGTH 128
+#endif //PACKED_LIST_BLOCK_LENGTH
+
+/* Number of bits needed to store `p_value`. */
+static inline uint8_t packed_list_width(uint64_t p_value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return p_value? 64 - __builtin_clzll(p_value): 0;
+#else
+    uint8_t width = 0;
+    while(p_value) { width++; p_value >>= 1; }
+    return width;
+#endif
+}
+
+/* Pack `PACKED_LIST_BLOCK_LENGTH` values into zeroed `r_words`. */
+static inline void packed_list_pack(const uint64_t* p_values, uint8_t p_width, uint64_t* r_words) {
+    if(!p_width) return;
+    for(list_uint i = 0; i < PACKED_LIST_BLOCK_LENGTH; i++) {
+        const uint64_t position = (uint64_t)i * p_width;
+        const unsigned shift = position & 63;
+        r_words[position >> 6] |= p_values[i] << shift;
+        if(shift + p_width > 64) r_words[(position >> 6) + 1] |= p_values[i] >> (64 - shift);
+    }
+}
+
+/* Unpack `PACKED_LIST_BLOCK_LENGTH` values from `p_words`.
+ * It may read one word past the block, which the packed list always pads. */
+static inline void packed_list_unpack(const uint64_t* p_words, uint8_t p_width, uint64_t* r_values) {
+    if(!p_width) {
+        memset(r_values, 0, PACKED_LIST_BLOCK_LENGTH * sizeof(uint64_t));
+        return;
+    }
+    const uint64_t mask = p_width == 64? UINT64_MAX: ((uint64_t)1 << p_width) - 1;
+#if defined(__SSE2__) && PACKED_LIST_BLOCK_LENGTH % 128 == 0
+    const __m128i masks = _mm_set1_epi64x((long long)mask);
+    for(list_uint base = 0; base < PACKED_LIST_BLOCK_LENGTH; base += 128) {
+        const uint64_t* words = p_words + (uint64_t)base / 64 * p_width;
+        for(list_uint i = 0; i < 64; i++) {
+            const uint64_t position = (uint64_t)i * p_width;
+            const uint64_t* word = words + (position >> 6);
+            const unsigned shift = position & 63;
+            const __m128i low = _mm_set_epi64x((long long)word[p_width], (long long)word[0]);
+            const __m128i high = _mm_set_epi64x((long long)word[p_width + 1], (long long)word[1]);
+            /* Shifting by 64 yields zero, so no special case for `shift == 0`. */
+            const __m128i values = _mm_and_si128(_mm_or_si128(
+                        _mm_srl_epi64(low, _mm_cvtsi32_si128((int)shift)),
+                        _mm_sll_epi64(high, _mm_cvtsi32_si128((int)(64 - shift)))), masks);
+            _mm_storel_epi64((__m128i*)(r_values + base + i), values);
+            _mm_storel_epi64((__m128i*)(r_values + base + i + 64), _mm_unpackhi_epi64(values, values));
+        }
+    }
+#else
+    for(list_uint i = 0; i < PACKED_LIST_BLOCK_LENGTH; i++) {
+        const uint64_t position = (uint64_t)i * p_width;
+        const uint64_t* word = p_words + (position >> 6);
+        const unsigned shift = position & 63;
+        r_values[i] = ((word[0] >> shift) | ((word[1] << 1) << (63 - shift))) & mask;
+    }
+#endif
+}
+
+/* # packed list structure
+ * >> struct ID_packed_list_skip
+ *
+ * @member
+ *  `first` - First item of the block.
+ *  `width` - Bit width of the deltas in the block.
+ *  `offset` - Offset of the block in `words`.
+ * <<
+ * >> struct ID_packed_list
+ *
+ * @member
+ *  `length` - Number of stored items.
+ *  `block_count` - Number of packed blocks.
+ *  `block_capacity` - Number of allocated skips.
+ *  `word_length` - Number of used words.
+ *  `word_capacity` - Number of allocated words.
+ *  `skips` - Array of skips, one per block.
+ *  `words` - Array of packed deltas.
+ *  `last` - Last appended item.
+ *  `tail` - Items not packed yet.
+ * <<
+ * */
+#define PACKED_LIST_DECLARE_STRUCT(mp_id, mp_keyword) \
+    mp_keyword struct mp_id ## _packed_list_skip; \
+    mp_keyword struct mp_id ## _packed_list;
+
+#define PACKED_LIST_DEFINE_STRUCT(mp_id, mp_type, mp_keyword) \
+    mp_keyword struct mp_id ## _packed_list_skip { \
+        mp_type first; \
+        uint8_t width; \
+        size_t offset; \
+    }; \
+    mp_keyword struct mp_id ## _packed_list { \
+        list_uint length; \
+        list_uint block_count; \
+        list_uint block_capacity; \
+        size_t word_length; \
+        size_t word_capacity; \
+        struct mp_id ## _packed_list_skip* skips; \
+        uint64_t* words; \
+        mp_type last; \
+        mp_type tail[PACKED_LIST_BLOCK_LENGTH]; \
+    }
+
+/* # Getter functions
+ * >> ID_packed_list_length
+ *  Get the length of packed list.
+ *
+ * @param
+ *  `p_list` - The packed list to be operated on.
+ *
+ * @return
+ *  % - Length of packed list.
+ *
+ * @noerror
+ * <<
+ * >> ID_packed_list_footprint
+ *  Get the number of bytes used by the packed list, including the structure.
+ *
+ * @param
+ *  `p_list` - The packed list to be operated on.
+ *
+ * @return
+ *  % - Number of bytes.
+ *
+ * @noerror
+ * <<
+ * >> ID_packed_list_decode_block
+ *  Decode a block into an array. The block after the last packed block is the
+ *  tail. Scanning block by block is the fastest way to read the items.
+ *
+ * @param
+ *  `p_list` - The packed list to be operated on.
+ *  `p_block` - Index of block, from 0 to `block_count` inclusive.
+ *
+ * @return
+ *  `r_items` - Array of at least `PACKED_LIST_BLOCK_LENGTH` items.
+ *  % - Number of decoded items, 0 when `p_block` is out of range.
+ *
+ * @noerror
+ * <<
+ * >> ID_packed_list_get
+ *  Get item by index. It decodes the block of the item.
+ *
+ * @param
+ *  `p_list` - The packed list to be operated on.
+ *  `p_index` - Index of item retreived.
+ *
+ * @return
+ *  `r_item` - Retreived item.
+ *
+ * @error
+ *  | When index requested is out of range, it fails.
+ *  % - `true` on success. `false` on fail.
+ * <<
+ * >> ID_packed_list_seek
+ *  Find the index of the first item not less than the item given, in
+ *  O(log(block count) + block length).
+ *
+ * @param
+ *  `p_list` - The packed list to be operated on.
+ *  `p_item` - Item to seek.
+ *
+ * @return
+ *  `r_index` - index of the item in the packed list.
+ *
+ * @error
+ *  | When all items are less than `p_item`, it fails.
+ *  % - `true` on success. `false` on fail.
+ * <<
+ * */
+#define PACKED_LIST_DECLARE_GETTER(mp_id, mp_type, mp_keyword) \
+    mp_keyword list_uint mp_id ## _packed_list_length(const struct mp_id ## _packed_list* p_list); \
+    mp_keyword size_t mp_id ## _packed_list_footprint(const struct mp_id ## _packed_list* p_list); \
+    mp_keyword list_uint mp_id ## _packed_list_decode_block(const struct mp_id ## _packed_list* p_list, list_uint p_block, mp_type* r_items); \
+    mp_keyword bool mp_id ## _packed_list_get(const struct mp_id ## _packed_list* p_list, list_uint p_index, mp_type* r_item); \
+    mp_keyword bool mp_id ## _packed_list_seek(const struct mp_id ## _packed_list* p_list, const mp_type p_item, list_uint* r_index);
+
+#define PACKED_LIST_DEFINE_GETTER(mp_id, mp_type, mp_keyword) \
+    mp_keyword list_uint mp_id ## _packed_list_length(const struct mp_id ## _packed_list* p_list) { \
+        return p_list->length; \
+    } \
+    mp_keyword size_t mp_id ## _packed_list_footprint(const struct mp_id ## _packed_list* p_list) { \
+        return sizeof(struct mp_id ## _packed_list) \
+            + p_list->block_capacity * sizeof(struct mp_id ## _packed_list_skip) \
+            + p_list->word_capacity * sizeof(uint64_t); \
+    } \
+    mp_keyword list_uint mp_id ## _packed_list_decode_block(const struct mp_id ## _packed_list* p_list, list_uint p_block, mp_type* r_items) { \
+        if(p_block > p_list->block_count) return 0; \
+        if(p_block == p_list->block_count) { \
+            const list_uint count = p_list->length - p_block * PACKED_LIST_BLOCK_LENGTH; \
+            memcpy(r_items, p_list->tail, count * sizeof(mp_type)); \
+            return count; \
+        } \
+        const struct mp_id ## _packed_list_skip* skip = p_list->skips + p_block; \
+        uint64_t deltas[PACKED_LIST_BLOCK_LENGTH]; \
+        packed_list_unpack(p_list->words + skip->offset, skip->width, deltas); \
+        mp_type item = skip->first; \
+        for(list_uint i = 0; i < PACKED_LIST_BLOCK_LENGTH; i++) { \
+            item += (mp_type)deltas[i]; \
+            r_items[i] = item; \
+        } \
+        return PACKED_LIST_BLOCK_LENGTH; \
+    } \
+    mp_keyword bool mp_id ## _packed_list_get(const struct mp_id ## _packed_list* p_list, list_uint p_index, mp_type* r_item) { \
+        if(p_index >= p_list->length) return false; \
+        mp_type items[PACKED_LIST_BLOCK_LENGTH]; \
+        mp_id ## _packed_list_decode_block(p_list, p_index / PACKED_LIST_BLOCK_LENGTH, items); \
+        if(r_item) *r_item = items[p_index % PACKED_LIST_BLOCK_LENGTH]; \
+        return true; \
+    } \
+    mp_keyword bool mp_id ## _packed_list_seek(const struct mp_id ## _packed_list* p_list, const mp_type p_item, list_uint* r_index) { \
+        const list_uint total = (p_list->length + PACKED_LIST_BLOCK_LENGTH - 1) / PACKED_LIST_BLOCK_LENGTH; \
+        list_uint low = 0; \
+        list_uint high = total; \
+        while(low < high) { \
+            const list_uint middle = low + (high - low) / 2; \
+            const mp_type first = middle < p_list->block_count? p_list->skips[middle].first: p_list->tail[0]; \
+            if(first < p_item) low = middle + 1; \
+            else high = middle; \
+        } \
+        if(low) { \
+            mp_type items[PACKED_LIST_BLOCK_LENGTH]; \
+            const list_uint count = mp_id ## _packed_list_decode_block(p_list, low - 1, items); \
+            for(list_uint i = 0; i < count; i++) \
+                if(items[i] >= p_item) { \
+                    *r_index = (low - 1) * PACKED_LIST_BLOCK_LENGTH + i; \
+                    return true; \
+                } \
+        } \
+        if(low == total) return false; \
+        *r_index = low * PACKED_LIST_BLOCK_LENGTH; \
+        return true; \
+    }
+
+/* # Setter functions
+ * >> ID_packed_list_new
+ *  Allocate memory for the packed list structure.
+ *
+ * @noparam
+ *
+ * @return
+ *  % - Pointer to the allocated packed list structure.
+ *
+ * @error
+ *  | When the allocator function fails, it fails.
+ *  % - Valid pointer on success. `NULL` on fail.
+ * <<
+ * >> ID_packed_list_free
+ *  Free the packed list structure together with the arrays.
+ *
+ * @param
+ *  `p_list` - The packed list to be operated.
+ *
+ * @noreturn
+ *
+ * @noerror
+ * <<
+ * >> ID_packed_list_free_items
+ *  Free the arrays of the packed list.
+ *
+ * @param
+ *  `p_list` - The packed list to be operated.
+ *
+ * @noreturn
+ *
+ * @noerror
+ * <<
+ * >> ID_packed_list_append
+ *  Append item at the back of the packed list. A full tail is packed into a
+ *  block.
+ *
+ * @param
+ *  `p_list` - The packed list to be operated.
+ *  `p_item` - New item.
+ *
+ * @noreturn
+ *
+ * @error
+ *  | When `p_item` is less than the last item, it fails.
+ *  | When fail to allocate an array, it fails.
+ *  % - `true` on succes. `false` on fail.
+ * <<
+ * >> ID_packed_list_append_array
+ *  Append items of an array at the back of the packed list.
+ *
+ * @param
+ *  `p_list` - The packed list to be operated.
+ *  `p_array` - Array of new items.
+ *  `p_length` - Length of the array.
+ *
+ * @noreturn
+ *
+ * @error
+ *  | When `ID_packed_list_append` fails, it fails. Items before the failing
+ *  | one stay appended.
+ *  % - `true` on succes. `false` on fail.
+ * <<
+ * */
+#define PACKED_LIST_DECLARE_SETTER(mp_id, mp_type, mp_keyword) \
+    mp_keyword struct mp_id ## _packed_list* mp_id ## _packed_list_new(); \
+    mp_keyword void mp_id ## _packed_list_free(struct mp_id ## _packed_list* p_list); \
+    mp_keyword void mp_id ## _packed_list_free_items(struct mp_id ## _packed_list* p_list); \
+    mp_keyword bool mp_id ## _packed_list_append(struct mp_id ## _packed_list* p_list, const mp_type p_item); \
+    mp_keyword bool mp_id ## _packed_list_append_array(struct mp_id ## _packed_list* p_list, const mp_type* p_array, list_uint p_length);
+
+#define PACKED_LIST_DEFINE_SETTER(mp_id, mp_type, mp_keyword) \
+    mp_keyword struct mp_id ## _packed_list* mp_id ## _packed_list_new() { \
+        return LIST_CALLOC(1, sizeof(struct mp_id ## _packed_list)); \
+    } \
+    mp_keyword void mp_id ## _packed_list_free_items(struct mp_id ## _packed_list* p_list) { \
+        if(p_list->block_capacity) LIST_FREE(p_list->skips); \
+        if(p_list->word_capacity) LIST_FREE(p_list->words); \
+    } \
+    mp_keyword void mp_id ## _packed_list_free(struct mp_id ## _packed_list* p_list) { \
+        mp_id ## _packed_list_free_items(p_list); \
+        LIST_FREE(p_list); \
+    } \
+    static bool mp_id ## _packed_list_pack_tail(struct mp_id ## _packed_list* p_list) { \
+        uint64_t deltas[PACKED_LIST_BLOCK_LENGTH]; \
+        uint64_t bits = 0; \
+        deltas[0] = 0; \
+        for(list_uint i = 1; i < PACKED_LIST_BLOCK_LENGTH; i++) { \
+            deltas[i] = p_list->tail[i] - p_list->tail[i - 1]; \
+            bits |= deltas[i]; \
+        } \
+        const uint8_t width = packed_list_width(bits); \
+        const size_t word_count = PACKED_LIST_BLOCK_LENGTH / 64 * width; \
+        if(p_list->block_count == p_list->block_capacity) { \
+            const list_uint new_capacity = p_list->block_capacity? p_list->block_capacity * 2: 8; \
+            struct mp_id ## _packed_list_skip* new_skips = LIST_REALLOC(p_list->skips, new_capacity * sizeof(struct mp_id ## _packed_list_skip)); \
+            if(!new_skips) return false; \
+            p_list->skips = new_skips; \
+            p_list->block_capacity = new_capacity; \
+        } \
+        /* One more word as padding of `packed_list_unpack`. */ \
+        if(p_list->word_length + word_count + 1 > p_list->word_capacity) { \
+            size_t new_capacity = p_list->word_capacity? p_list->word_capacity: PACKED_LIST_BLOCK_LENGTH; \
+            while(new_capacity < p_list->word_length + word_count + 1) new_capacity *= 2; \
+            uint64_t* new_words = LIST_REALLOC(p_list->words, new_capacity * sizeof(uint64_t)); \
+            if(!new_words) return false; \
+            p_list->words = new_words; \
+            p_list->word_capacity = new_capacity; \
+        } \
+        memset(p_list->words + p_list->word_length, 0, (word_count + 1) * sizeof(uint64_t)); \
+        packed_list_pack(deltas, width, p_list->words + p_list->word_length); \
+        p_list->skips[p_list->block_count].first = p_list->tail[0]; \
+        p_list->skips[p_list->block_count].width = width; \
+        p_list->skips[p_list->block_count].offset = p_list->word_length; \
+        p_list->word_length += word_count; \
+        p_list->block_count++; \
+        return true; \
+    } \
+    mp_keyword bool mp_id ## _packed_list_append(struct mp_id ## _packed_list* p_list, const mp_type p_item) { \
+        if(p_list->length && p_item < p_list->last) return false; \
+        const list_uint tail_length = p_list->length - p_list->block_count * PACKED_LIST_BLOCK_LENGTH; \
+        p_list->tail[tail_length] = p_item; \
+        if(tail_length + 1 == PACKED_LIST_BLOCK_LENGTH && !mp_id ## _packed_list_pack_tail(p_list)) return false; \
+        p_list->last = p_item; \
+        p_list->length++; \
+        return true; \
+    } \
+    mp_keyword bool mp_id ## _packed_list_append_array(struct mp_id ## _packed_list* p_list, const mp_type* p_array, list_uint p_length) { \
+        for(list_uint i = 0; i < p_length; i++) \
+            if(!mp_id ## _packed_list_append(p_list, p_array[i])) return false; \
+        return true; \
+    }
+
+/* # Converter functions
+ * >> ID_packed_list_to_list
+ *  Decode the packed list into a list, replacing its items.
+ *
+ * @param
+ *  `p_list` - The packed list to be operated on.
+ *
+ * @return
+ *  `r_list` - Target list to be decoded to.
+ *
+ * @error
+ *  | When fail to allocate an array, it fails.
+ *  % - `true` on success. `false` on fail.
+ * <<
+ * */
+#define PACKED_LIST_DECLARE_CONVERTER(mp_id, mp_list_id, mp_keyword) \
+    mp_keyword bool mp_id ## _packed_list_to_list(const struct mp_id ## _packed_list* p_list, struct mp_list_id ## _list* r_list);
+
+#define PACKED_LIST_DEFINE_CONVERTER(mp_id, mp_list_id, mp_keyword) \
+    mp_keyword bool mp_id ## _packed_list_to_list(const struct mp_id ## _packed_list* p_list, struct mp_list_id ## _list* r_list) { \
+        if(!mp_list_id ## _list_reserve(r_list, p_list->length)) return false; \
+        for(list_uint i = 0; i * PACKED_LIST_BLOCK_LENGTH < p_list->length; i++) \
+            mp_id ## _packed_list_decode_block(p_list, i, r_list->items + i * PACKED_LIST_BLOCK_LENGTH); \
+        r_list->length = p_list->length; \
+        return true; \
+    }
+
+#endif //_PACKED_LIST_H_
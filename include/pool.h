@@ -0,0 +1,358 @@
+#ifndef _POOL_H_
+#define _POOL_H_
+
+/* # pool
+ * This file contains macro for declaring and defining fixed-size object pool
+ * of desired type, so node-based structures don't hit the allocator per node.
+ *
+ * ## Usage
+ * 1. Declare & define the pool with the macros (or `POOL_DEFINE` for both
+ * structure and functions). `mp_id`, `mp_type` and `mp_keyword` mean the
+ * same as in `list.h`.
+ * 2. Initialize the pool on stack or as global, `struct ID_pool pool = {0};`.
+ * 3. Allocate & release objects (`ID_pool_alloc`, `ID_pool_release`), or
+ * release all objects at once (`ID_pool_clear`).
+ * 4. Free the pool with `ID_pool_free_items`, all objects are freed with it.
+ *
+ * ## Slab
+ * Objects are carved out of slabs, starting at `POOL_SLAB_LENGTH` objects and
+ * doubling up to `POOL_MAX_SLAB_LENGTH`. A released object is pushed onto an
+ * intrusive free list, the link is stored in the object itself, so a free
+ * object costs no memory besides itself.
+ *
+ * ## Thread-local cache
+ * The pool itself is NOT thread safe. For many threads, share one pool and
+ * give every thread a cache, e.g.:
+ *  static struct ID_pool pool = {0};
+ *  static _Thread_local struct ID_pool_cache cache = {.pool = &pool};
+ * The cache allocates & releases without lock, and only locks the pool to
+ * refill or return `POOL_CACHE_BATCH_LENGTH` objects at once. Call
+ * `ID_pool_cache_flush` before a thread exits. Don't use the pool directly
+ * while caches are in use.
+ *
+ * ## List structure
+ * To draw the structures of `ID_list_new` from a pool, e.g. for `int` list:
+ *  #define LIST_HEADER_ALLOC(mp_id) mp_id ## _list_pool_alloc(&mp_id ## _list_pool)
+ *  #define LIST_HEADER_FREE(mp_id, mp_list) mp_id ## _list_pool_release(&mp_id ## _list_pool, mp_list)
+ *  #include <list.h>
+ *  #include <pool.h>
+ *  LIST_DEFINE_STRUCT(int, int, );
+ *  POOL_DEFINE(int_list, struct int_list, static);
+ *  static struct int_list_pool int_list_pool = {0};
+ *  LIST_DEFINE_SETTER(int, int, static);
+ *
+ * ## Memory
+ * Slabs are allocated through `LIST_CALLOC` and `LIST_FREE` of `list.h`. */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "list.h"
+
+#ifndef POOL_SLAB_LENGTH
+#define POOL_SLAB_LENGTH 64
+#endif //POOL_SLAB_LENGTH
+
+#ifndef POOL_MAX_SLAB_LENGTH
+#define POOL_MAX_SLAB_LENGTH 4096
+#endif //POOL_MAX_SLAB_LENGTH
+
+#ifndef POOL_CACHE_BATCH_LENGTH
+#define POOL_CACHE_BATCH_LENGTH 32
+#endif //POOL_CACHE_BATCH_LENGTH
+
+/* # pool structure
+ * >> union ID_pool_node
+ *  An object, or the link of free list when the object is free.
+ * <<
+ * >> struct ID_pool_slab
+ *
+ * @member
+ *  `next` - Next slab.
+ *  `length` - Number of objects in the slab.
+ *  `nodes` - Objects.
+ * <<
+ * >> struct ID_pool
+ *
+ * @member
+ *  `free` - Free list.
+ *  `slabs` - List of slabs.
+ *  `slab_length` - Number of objects of the next slab.
+ *  `length` - Number of objects allocated out of the pool.
+ *  `lock` - Lock for the caches.
+ * <<
+ * >> struct ID_pool_cache
+ *
+ * @member
+ *  `pool` - Shared pool.
+ *  `free` - Free list.
+ *  `length` - Number of objects in the free list.
+ * <<
+ * */
+#define POOL_DECLARE_STRUCT(mp_id, mp_keyword) \
+    mp_keyword union mp_id ## _pool_node; \
+    mp_keyword struct mp_id ## _pool_slab; \
+    mp_keyword struct mp_id ## _pool; \
+    mp_keyword struct mp_id ## _pool_cache;
+
+#define POOL_DEFINE_STRUCT(mp_id, mp_type, mp_keyword) \
+    mp_keyword union mp_id ## _pool_node { \
+        union mp_id ## _pool_node* next; \
+        mp_type item; \
+    }; \
+    mp_keyword struct mp_id ## _pool_slab { \
+        struct mp_id ## _pool_slab* next; \
+        list_uint length; \
+        union mp_id ## _pool_node nodes[]; \
+    }; \
+    mp_keyword struct mp_id ## _pool { \
+        union mp_id ## _pool_node* free; \
+        struct mp_id ## _pool_slab* slabs; \
+        list_uint slab_length; \
+        list_uint length; \
+        atomic_flag lock; \
+    }; \
+    mp_keyword struct mp_id ## _pool_cache { \
+        struct mp_id ## _pool* pool; \
+        union mp_id ## _pool_node* free; \
+        list_uint length; \
+    }
+
+/* # Pool functions
+ * >> ID_pool_free_items
+ *  Free every slab of the pool, together with the objects in them.
+ *
+ * @param
+ *  `p_pool` - The pool to be operated.
+ *
+ * @noreturn
+ *
+ * @noerror
+ * <<
+ * >> ID_pool_alloc
+ *  Allocate an object, its content is undefined.
+ *
+ * @param
+ *  `p_pool` - The pool to be operated.
+ *
+ * @return
+ *  % - Pointer to the object.
+ *
+ * @error
+ *  | When fail to allocate a slab, it fails.
+ *  % - Valid pointer on success. `NULL` on fail.
+ * <<
+ * >> ID_pool_release
+ *  Release an object back to the pool.
+ *
+ * @param
+ *  `p_pool` - The pool to be operated.
+ *  `p_item` - Object allocated from the pool.
+ *
+ * @noreturn
+ *
+ * @noerror
+ * <<
+ * >> ID_pool_release_array
+ *  Release objects back to the pool, spliced into the free list at once.
+ *
+ * @param
+ *  `p_pool` - The pool to be operated.
+ *  `p_items` - Array of objects allocated from the pool.
+ *  `p_length` - Length of the array.
+ *
+ * @noreturn
+ *
+ * @noerror
+ * <<
+ * >> ID_pool_clear
+ *  Release every object of the pool at once, keeping the slabs.
+ *
+ * @param
+ *  `p_pool` - The pool to be operated.
+ *
+ * @noreturn
+ *
+ * @noerror
+ * <<
+ * */
+#define POOL_DECLARE_FUNCTION(mp_id, mp_type, mp_keyword) \
+    mp_keyword void mp_id ## _pool_free_items(struct mp_id ## _pool* p_pool); \
+    mp_keyword mp_type* mp_id ## _pool_alloc(struct mp_id ## _pool* p_pool); \
+    mp_keyword void mp_id ## _pool_release(struct mp_id ## _pool* p_pool, mp_type* p_item); \
+    mp_keyword void mp_id ## _pool_release_array(struct mp_id ## _pool* p_pool, mp_type** p_items, list_uint p_length); \
+    mp_keyword void mp_id ## _pool_clear(struct mp_id ## _pool* p_pool); \
+    POOL_DECLARE_CACHE_FUNCTION(mp_id, mp_type, mp_keyword)
+
+#define POOL_DEFINE_FUNCTION(mp_id, mp_type, mp_keyword) \
+    mp_keyword void mp_id ## _pool_free_items(struct mp_id ## _pool* p_pool) { \
+        while(p_pool->slabs) { \
+            struct mp_id ## _pool_slab* next = p_pool->slabs->next; \
+            LIST_FREE(p_pool->slabs); \
+            p_pool->slabs = next; \
+        } \
+        p_pool->free = NULL; \
+        p_pool->length = 0; \
+    } \
+    static bool mp_id ## _pool_grow(struct mp_id ## _pool* p_pool) { \
+        const list_uint length = p_pool->slab_length? p_pool->slab_length: POOL_SLAB_LENGTH; \
+        struct mp_id ## _pool_slab* slab = LIST_CALLOC(1, sizeof(struct mp_id ## _pool_slab) + length * sizeof(union mp_id ## _pool_node)); \
+        if(!slab) return false; \
+        slab->length = length; \
+        slab->next = p_pool->slabs; \
+        p_pool->slabs = slab; \
+        for(list_uint i = length; i > 0; i--) { \
+            slab->nodes[i - 1].next = p_pool->free; \
+            p_pool->free = slab->nodes + i - 1; \
+        } \
+        p_pool->slab_length = length * 2 > POOL_MAX_SLAB_LENGTH? POOL_MAX_SLAB_LENGTH: length * 2; \
+        return true; \
+    } \
+    mp_keyword mp_type* mp_id ## _pool_alloc(struct mp_id ## _pool* p_pool) { \
+        if(!p_pool->free && !mp_id ## _pool_grow(p_pool)) return NULL; \
+        union mp_id ## _pool_node* node = p_pool->free; \
+        p_pool->free = node->next; \
+        p_pool->length++; \
+        return &node->item; \
+    } \
+    mp_keyword void mp_id ## _pool_release(struct mp_id ## _pool* p_pool, mp_type* p_item) { \
+        union mp_id ## _pool_node* node = (union mp_id ## _pool_node*)p_item; \
+        node->next = p_pool->free; \
+        p_pool->free = node; \
+        p_pool->length--; \
+    } \
+    mp_keyword void mp_id ## _pool_release_array(struct mp_id ## _pool* p_pool, mp_type** p_items, list_uint p_length) { \
+        if(!p_length) return; \
+        for(list_uint i = 0; i + 1 < p_length; i++) \
+            ((union mp_id ## _pool_node*)p_items[i])->next = (union mp_id ## _pool_node*)p_items[i + 1]; \
+        ((union mp_id ## _pool_node*)p_items[p_length - 1])->next = p_pool->free; \
+        p_pool->free = (union mp_id ## _pool_node*)p_items[0]; \
+        p_pool->length -= p_length; \
+    } \
+    mp_keyword void mp_id ## _pool_clear(struct mp_id ## _pool* p_pool) { \
+        p_pool->free = NULL; \
+        for(struct mp_id ## _pool_slab* slab = p_pool->slabs; slab; slab = slab->next) \
+            for(list_uint i = slab->length; i > 0; i--) { \
+                slab->nodes[i - 1].next = p_pool->free; \
+                p_pool->free = slab->nodes + i - 1; \
+            } \
+        p_pool->length = 0; \
+    } \
+    POOL_DEFINE_CACHE_FUNCTION(mp_id, mp_type, mp_keyword)
+
+/* # Cache functions
+ * These functions are thread safe as long as every thread has its own cache.
+ *
+ * >> ID_pool_cache_alloc
+ *  Allocate an object from the cache, refilled by a batch from the shared
+ *  pool when empty. Its content is undefined.
+ *
+ * @param
+ *  `p_cache` - The cache to be operated.
+ *
+ * @return
+ *  % - Pointer to the object.
+ *
+ * @error
+ *  | When fail to allocate a slab, it fails.
+ *  % - Valid pointer on success. `NULL` on fail.
+ * <<
+ * >> ID_pool_cache_release
+ *  Release an object to the cache. When the cache holds too many objects, a
+ *  batch is returned to the shared pool.
+ *  The object may be allocated from any cache of the same pool.
+ *
+ * @param
+ *  `p_cache` - The cache to be operated.
+ *  `p_item` - Object allocated from the pool.
+ *
+ * @noreturn
+ *
+ * @noerror
+ * <<
+ * >> ID_pool_cache_flush
+ *  Return every object in the cache to the shared pool.
+ *
+ * @param
+ *  `p_cache` - The cache to be operated.
+ *
+ * @noreturn
+ *
+ * @noerror
+ * <<
+ * */
+#define POOL_DECLARE_CACHE_FUNCTION(mp_id, mp_type, mp_keyword) \
+    mp_keyword mp_type* mp_id ## _pool_cache_alloc(struct mp_id ## _pool_cache* p_cache); \
+    mp_keyword void mp_id ## _pool_cache_release(struct mp_id ## _pool_cache* p_cache, mp_type* p_item); \
+    mp_keyword void mp_id ## _pool_cache_flush(struct mp_id ## _pool_cache* p_cache);
+
+#define POOL_DEFINE_CACHE_FUNCTION(mp_id, mp_type, mp_keyword) \
+    static void mp_id ## _pool_lock(struct mp_id ## _pool* p_pool) { \
+        while(atomic_flag_test_and_set_explicit(&p_pool->lock, memory_order_acquire)); \
+    } \
+    static void mp_id ## _pool_unlock(struct mp_id ## _pool* p_pool) { \
+        atomic_flag_clear_explicit(&p_pool->lock, memory_order_release); \
+    } \
+    /* Move up to `p_count` objects of the cache to the shared pool. */ \
+    static void mp_id ## _pool_cache_return(struct mp_id ## _pool_cache* p_cache, list_uint p_count) { \
+        if(!p_cache->free) return; \
+        union mp_id ## _pool_node* first = p_cache->free; \
+        union mp_id ## _pool_node* last = first; \
+        list_uint count = 1; \
+        while(count < p_count && last->next) { \
+            last = last->next; \
+            count++; \
+        } \
+        p_cache->free = last->next; \
+        p_cache->length -= count; \
+        mp_id ## _pool_lock(p_cache->pool); \
+        last->next = p_cache->pool->free; \
+        p_cache->pool->free = first; \
+        p_cache->pool->length -= count; \
+        mp_id ## _pool_unlock(p_cache->pool); \
+    } \
+    mp_keyword mp_type* mp_id ## _pool_cache_alloc(struct mp_id ## _pool_cache* p_cache) { \
+        if(!p_cache->free) { \
+            struct mp_id ## _pool* pool = p_cache->pool; \
+            mp_id ## _pool_lock(pool); \
+            while(p_cache->length < POOL_CACHE_BATCH_LENGTH) { \
+                if(!pool->free && !mp_id ## _pool_grow(pool)) break; \
+                union mp_id ## _pool_node* node = pool->free; \
+                pool->free = node->next; \
+                node->next = p_cache->free; \
+                p_cache->free = node; \
+                p_cache->length++; \
+                pool->length++; \
+            } \
+            mp_id ## _pool_unlock(pool); \
+            if(!p_cache->free) return NULL; \
+        } \
+        union mp_id ## _pool_node* node = p_cache->free; \
+        p_cache->free = node->next; \
+        p_cache->length--; \
+        return &node->item; \
+    } \
+    mp_keyword void mp_id ## _pool_cache_release(struct mp_id ## _pool_cache* p_cache, mp_type* p_item) { \
+        union mp_id ## _pool_node* node = (union mp_id ## _pool_node*)p_item; \
+        node->next = p_cache->free; \
+        p_cache->free = node; \
+        if(++p_cache->length >= 2 * POOL_CACHE_BATCH_LENGTH) \
+            mp_id ## _pool_cache_return(p_cache, POOL_CACHE_BATCH_LENGTH); \
+    } \
+    mp_keyword void mp_id ## _pool_cache_flush(struct mp_id ## _pool_cache* p_cache) { \
+        mp_id ## _pool_cache_return(p_cache, p_cache->length); \
+    }
+
+/* Declare & define both structure and functions of pool, `mp_keyword` only
+ * applies to the functions. */
+#define POOL_DECLARE(mp_id, mp_type, mp_keyword) \
+    POOL_DECLARE_STRUCT(mp_id, ) \
+    POOL_DECLARE_FUNCTION(mp_id, mp_type, mp_keyword)
+
+#define POOL_DEFINE(mp_id, mp_type, mp_keyword) \
+    POOL_DEFINE_STRUCT(mp_id, mp_type, ); \
+    POOL_DEFINE_FUNCTION(mp_id, mp_type, mp_keyword)
+
+#endif //_POOL_H_
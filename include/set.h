@@ -0,0 +1,422 @@
+#ifndef _SET_H_
+#define _SET_H_
+
+/* # set
+ * This file contains macro for declaring and defining hash set that stores
+ * desired type, for fast membership test & deduplication.
+ *
+ * ## Usage
+ * Same as `list.h`: declare & define the set with the macros, then initialize
+ * it on stack (`struct ID_set set = {0};`) or heap (`ID_set_new`), and free it
+ * with `ID_set_free_items` or `ID_set_free` respectively. `mp_id`, `mp_type`
+ * and `mp_keyword` mean the same as in `list.h`. Besides:
+ * `mp_hash` is the hash function (or function-like macro) of the item,
+ * `uint64_t mp_hash(const mp_type p_item)`, e.g. `set_hash_integer`.
+ * `mp_equal` is the equality function (or function-like macro) of the items,
+ * `bool mp_equal(const mp_type p_a, const mp_type p_b)`, e.g.
+ * `SET_EQUAL_PRIMITIVE`.
+ *
+ * ## Layout
+ * The set is an open-addressing table in the Swiss table style. Every slot
+ * has a control byte: empty, deleted, or the low 7 bits of the item's hash.
+ * The table is probed `SET_GROUP_LENGTH` control bytes at a time, compared
+ * with one SSE2 instruction (or a portable loop), so the items themselves are
+ * only compared on probable hit. The control bytes of the first group are
+ * mirrored after the last one, so a group never wraps.
+ *
+ * To reject definite misses before hitting the set, see `bloom.h`.
+ *
+ * ## Memory
+ * Allocation goes through `LIST_CALLOC` and `LIST_FREE` of `list.h`. As for
+ * list, don't modify the members or give NULL pointer. */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "list.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define SET_GROUP_LENGTH 16
+#define SET_CONTROL_EMPTY ((int8_t)-128)
+#define SET_CONTROL_DELETED ((int8_t)-2)
+
+/* Must be a power of 2, not less than `SET_GROUP_LENGTH`. */
+#ifndef SET_INIT_CAPACITY
+#define SET_INIT_CAPACITY 16
+#endif //SET_INIT_CAPACITY
+
+/* Number of items hashed & prefetched ahead by the batch functions. */
+#ifndef SET_BATCH_LENGTH
+#define SET_BATCH_LENGTH 16
+#endif //SET_BATCH_LENGTH
+
+/* Equality of primitive type, for `mp_equal`. */
+#define SET_EQUAL_PRIMITIVE(mp_a, mp_b) ((mp_a) == (mp_b))
+
+/* Hash of integer (splitmix64 finalizer), for `mp_hash`. */
+static inline uint64_t set_hash_integer(uint64_t p_item) {
+    p_item ^= p_item >> 30;
+    p_item *= 0xbf58476d1ce4e5b9ULL;
+    p_item ^= p_item >> 27;
+    p_item *= 0x94d049bb133111ebULL;
+    return p_item ^ (p_item >> 31);
+}
+
+/* Bit mask of the control bytes in the group equal to `p_control`. */
+static inline uint32_t set_group_match(const int8_t* p_group, int8_t p_control) {
+#ifdef __SSE2__
+    const __m128i group = _mm_loadu_si128((const __m128i*)p_group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(p_control)));
+#else
+    uint32_t mask = 0;
+    for(uint32_t i = 0; i < SET_GROUP_LENGTH; i++) mask |= (uint32_t)(p_group[i] == p_control) << i;
+    return mask;
+#endif
+}
+
+/* Bit mask of the empty or deleted control bytes in the group. */
+static inline uint32_t set_group_match_free(const int8_t* p_group) {
+#ifdef __SSE2__
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)p_group));
+#else
+    uint32_t mask = 0;
+    for(uint32_t i = 0; i < SET_GROUP_LENGTH; i++) mask |= (uint32_t)(p_group[i] < 0) << i;
+    return mask;
+#endif
+}
+
+/* Index of the lowest set bit of a non-zero mask. */
+static inline uint32_t set_lowest_bit(uint32_t p_mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(p_mask);
+#else
+    uint32_t index = 0;
+    while(!(p_mask & 1)) { p_mask >>= 1; index++; }
+    return index;
+#endif
+}
+
+/* # set structure
+ * >> struct ID_set
+ *
+ * @member
+ *  `capacity` - Number of slots, 0 or a power of 2.
+ *  `length` - Number of stored items.
+ *  `growth_left` - Number of items insertable before rehashing.
+ *  `controls` - Array of control bytes, `capacity + SET_GROUP_LENGTH` long.
+ *  `slots` - Array of items.
+ * <<
+ * */
+#define SET_DECLARE_STRUCT(mp_id, mp_keyword) \
+    mp_keyword struct mp_id ## _set;
+
+#define SET_DEFINE_STRUCT(mp_id, mp_type, mp_keyword) \
+    mp_keyword struct mp_id ## _set { \
+        list_uint capacity; \
+        list_uint length; \
+        list_uint growth_left; \
+        int8_t* controls; \
+        mp_type* slots; \
+    }
+
+/* # Functions
+ * >> ID_set_new
+ *  Allocate memory for the set structure.
+ *
+ * @noparam
+ *
+ * @return
+ *  % - Pointer to the allocated set structure.
+ *
+ * @error
+ *  | When the allocator function fails, it fails.
+ *  % - Valid pointer on success. `NULL` on fail.
+ * <<
+ * >> ID_set_free
+ *  Free the set structure together with the arrays.
+ *
+ * @param
+ *  `p_set` - The set to be operated.
+ *
+ * @noreturn
+ *
+ * @noerror
+ * <<
+ * >> ID_set_free_items
+ *  Free the arrays of the set.
+ *
+ * @param
+ *  `p_set` - The set to be operated.
+ *
+ * @noreturn
+ *
+ * @noerror
+ * <<
+ * >> ID_set_length
+ *  Get the number of items in the set.
+ *
+ * @param
+ *  `p_set` - The set to be operated on.
+ *
+ * @return
+ *  % - Number of items.
+ *
+ * @noerror
+ * <<
+ * >> ID_set_reserve
+ *  Make sure `p_count` items fit in the set without rehashing.
+ *
+ * @param
+ *  `p_set` - The set to be operated.
+ *  `p_count` - Number of items.
+ *
+ * @noreturn
+ *
+ * @error
+ *  | When fail to allocate an array, it fails.
+ *  % - `true` on success. `false` on fail.
+ * <<
+ * >> ID_set_contains
+ *  Check whether the item is in the set.
+ *
+ * @param
+ *  `p_set` - The set to be operated on.
+ *  `p_item` - Item to check.
+ *
+ * @return
+ *  % - `true` if the item is in the set, else `false`.
+ *
+ * @noerror
+ * <<
+ * >> ID_set_insert
+ *  Insert item into the set, unless it is already in.
+ *
+ * @param
+ *  `p_set` - The set to be operated.
+ *  `p_item` - New item.
+ *
+ * @return
+ *  `r_is_new` - `true` when the item was not in the set. Optional.
+ *
+ * @error
+ *  | When fail to allocate an array, it fails.
+ *  % - `true` on success. `false` on fail.
+ * <<
+ * >> ID_set_erase
+ *  Remove item from the set.
+ *
+ * @param
+ *  `p_set` - The set to be operated.
+ *  `p_item` - Item to remove.
+ *
+ * @noreturn
+ *
+ * @error
+ *  | When the item is not in the set, it fails.
+ *  % - `true` on success. `false` on fail.
+ * <<
+ * >> ID_set_insert_array
+ *  Insert the items of an array. The items are hashed and their probe
+ *  positions prefetched `SET_BATCH_LENGTH` at a time.
+ *
+ * @param
+ *  `p_set` - The set to be operated.
+ *  `p_array` - Array of new items.
+ *  `p_length` - Length of the array.
+ *
+ * @return
+ *  `r_is_new` - Array of `p_length`, whether each item was not in the set
+ *  (nor earlier in the array). Optional.
+ *
+ * @error
+ *  | When fail to allocate an array, it fails. Items before the failing batch
+ *  | stay inserted.
+ *  % - `true` on success. `false` on fail.
+ * <<
+ * >> ID_set_contains_array
+ *  Check whether the items of an array are in the set. The items are hashed
+ *  and their probe positions prefetched `SET_BATCH_LENGTH` at a time.
+ *
+ * @param
+ *  `p_set` - The set to be operated on.
+ *  `p_array` - Array of items to check.
+ *  `p_length` - Length of the array.
+ *
+ * @return
+ *  `r_results` - Array of `p_length`, whether each item is in the set.
+ *  Optional.
+ *  % - Number of items in the set.
+ *
+ * @noerror
+ * <<
+ * */
+#define SET_DECLARE_FUNCTION(mp_id, mp_type, mp_keyword) \
+    mp_keyword struct mp_id ## _set* mp_id ## _set_new(); \
+    mp_keyword void mp_id ## _set_free(struct mp_id ## _set* p_set); \
+    mp_keyword void mp_id ## _set_free_items(struct mp_id ## _set* p_set); \
+    mp_keyword list_uint mp_id ## _set_length(const struct mp_id ## _set* p_set); \
+    mp_keyword bool mp_id ## _set_reserve(struct mp_id ## _set* p_set, list_uint p_count); \
+    mp_keyword bool mp_id ## _set_contains(const struct mp_id ## _set* p_set, const mp_type p_item); \
+    mp_keyword bool mp_id ## _set_insert(struct mp_id ## _set* p_set, const mp_type p_item, bool* r_is_new); \
+    mp_keyword bool mp_id ## _set_erase(struct mp_id ## _set* p_set, const mp_type p_item); \
+    mp_keyword bool mp_id ## _set_insert_array(struct mp_id ## _set* p_set, const mp_type* p_array, list_uint p_length, bool* r_is_new); \
+    mp_keyword list_uint mp_id ## _set_contains_array(const struct mp_id ## _set* p_set, const mp_type* p_array, list_uint p_length, bool* r_results);
+
+#define SET_DEFINE_FUNCTION(mp_id, mp_type, mp_hash, mp_equal, mp_keyword) \
+    mp_keyword struct mp_id ## _set* mp_id ## _set_new() { \
+        return LIST_CALLOC(1, sizeof(struct mp_id ## _set)); \
+    } \
+    mp_keyword void mp_id ## _set_free_items(struct mp_id ## _set* p_set) { \
+        if(!p_set->capacity) return; \
+        LIST_FREE(p_set->controls); \
+        LIST_FREE(p_set->slots); \
+    } \
+    mp_keyword void mp_id ## _set_free(struct mp_id ## _set* p_set) { \
+        mp_id ## _set_free_items(p_set); \
+        LIST_FREE(p_set); \
+    } \
+    mp_keyword list_uint mp_id ## _set_length(const struct mp_id ## _set* p_set) { \
+        return p_set->length; \
+    } \
+    static void mp_id ## _set_control(struct mp_id ## _set* p_set, list_uint p_slot, int8_t p_control) { \
+        p_set->controls[p_slot] = p_control; \
+        p_set->controls[((p_slot - SET_GROUP_LENGTH) & (p_set->capacity - 1)) + SET_GROUP_LENGTH] = p_control; \
+    } \
+    static bool mp_id ## _set_locate(const struct mp_id ## _set* p_set, const mp_type p_item, uint64_t p_hash, list_uint* r_slot) { \
+        if(!p_set->capacity) return false; \
+        const list_uint mask = p_set->capacity - 1; \
+        const int8_t control = (int8_t)(p_hash & 0x7F); \
+        list_uint position = (list_uint)(p_hash >> 7) & mask; \
+        for(list_uint step = SET_GROUP_LENGTH;; step += SET_GROUP_LENGTH) { \
+            const int8_t* group = p_set->controls + position; \
+            for(uint32_t match = set_group_match(group, control); match; match &= match - 1) { \
+                const list_uint slot = (position + set_lowest_bit(match)) & mask; \
+                if(mp_equal(p_set->slots[slot], p_item)) { \
+                    *r_slot = slot; \
+                    return true; \
+                } \
+            } \
+            if(set_group_match(group, SET_CONTROL_EMPTY)) return false; \
+            position = (position + step) & mask; \
+        } \
+    } \
+    static list_uint mp_id ## _set_locate_free(const struct mp_id ## _set* p_set, uint64_t p_hash) { \
+        const list_uint mask = p_set->capacity - 1; \
+        list_uint position = (list_uint)(p_hash >> 7) & mask; \
+        for(list_uint step = SET_GROUP_LENGTH;; step += SET_GROUP_LENGTH) { \
+            const uint32_t match = set_group_match_free(p_set->controls + position); \
+            if(match) return (position + set_lowest_bit(match)) & mask; \
+            position = (position + step) & mask; \
+        } \
+    } \
+    static bool mp_id ## _set_rehash(struct mp_id ## _set* p_set, list_uint p_capacity) { \
+        int8_t* controls = LIST_CALLOC(p_capacity + SET_GROUP_LENGTH, sizeof(int8_t)); \
+        mp_type* slots = LIST_CALLOC(p_capacity, sizeof(mp_type)); \
+        if(!controls || !slots) { \
+            if(controls) LIST_FREE(controls); \
+            if(slots) LIST_FREE(slots); \
+            return false; \
+        } \
+        memset(controls, SET_CONTROL_EMPTY, p_capacity + SET_GROUP_LENGTH); \
+        struct mp_id ## _set set = {p_capacity, p_set->length, p_capacity / 8 * 7 - p_set->length, controls, slots}; \
+        for(list_uint i = 0; i < p_set->capacity; i++) { \
+            if(p_set->controls[i] < 0) continue; \
+            const uint64_t hash = mp_hash(p_set->slots[i]); \
+            const list_uint slot = mp_id ## _set_locate_free(&set, hash); \
+            mp_id ## _set_control(&set, slot, (int8_t)(hash & 0x7F)); \
+            set.slots[slot] = p_set->slots[i]; \
+        } \
+        mp_id ## _set_free_items(p_set); \
+        *p_set = set; \
+        return true; \
+    } \
+    static bool mp_id ## _set_grow(struct mp_id ## _set* p_set, list_uint p_count) { \
+        if(p_count <= p_set->growth_left) return true; \
+        const uint64_t length = (uint64_t)p_set->length + p_count; \
+        uint64_t capacity = p_set->capacity; \
+        /* Rehash in place when tombstones, not items, used up the growth. */ \
+        if(!capacity || length > capacity / 16 * 7) { \
+            capacity = capacity? capacity * 2: SET_INIT_CAPACITY; \
+            while(capacity / 8 * 7 < length) capacity *= 2; \
+        } \
+        if(capacity > UINT32_MAX) return false; \
+        return mp_id ## _set_rehash(p_set, (list_uint)capacity); \
+    } \
+    mp_keyword bool mp_id ## _set_reserve(struct mp_id ## _set* p_set, list_uint p_count) { \
+        if(p_count <= p_set->length) return true; \
+        return mp_id ## _set_grow(p_set, p_count - p_set->length); \
+    } \
+    mp_keyword bool mp_id ## _set_contains(const struct mp_id ## _set* p_set, const mp_type p_item) { \
+        list_uint slot = 0; \
+        return mp_id ## _set_locate(p_set, p_item, mp_hash(p_item), &slot); \
+    } \
+    static void mp_id ## _set_put(struct mp_id ## _set* p_set, const mp_type p_item, uint64_t p_hash) { \
+        const list_uint slot = mp_id ## _set_locate_free(p_set, p_hash); \
+        if(p_set->controls[slot] == SET_CONTROL_EMPTY) p_set->growth_left--; \
+        mp_id ## _set_control(p_set, slot, (int8_t)(p_hash & 0x7F)); \
+        p_set->slots[slot] = p_item; \
+        p_set->length++; \
+    } \
+    mp_keyword bool mp_id ## _set_insert(struct mp_id ## _set* p_set, const mp_type p_item, bool* r_is_new) { \
+        const uint64_t hash = mp_hash(p_item); \
+        list_uint slot = 0; \
+        const bool is_new = !mp_id ## _set_locate(p_set, p_item, hash, &slot); \
+        if(is_new) { \
+            if(!mp_id ## _set_grow(p_set, 1)) return false; \
+            mp_id ## _set_put(p_set, p_item, hash); \
+        } \
+        if(r_is_new) *r_is_new = is_new; \
+        return true; \
+    } \
+    mp_keyword bool mp_id ## _set_erase(struct mp_id ## _set* p_set, const mp_type p_item) { \
+        list_uint slot = 0; \
+        if(!mp_id ## _set_locate(p_set, p_item, mp_hash(p_item), &slot)) return false; \
+        mp_id ## _set_control(p_set, slot, SET_CONTROL_DELETED); \
+        p_set->length--; \
+        return true; \
+    } \
+    mp_keyword bool mp_id ## _set_insert_array(struct mp_id ## _set* p_set, const mp_type* p_array, list_uint p_length, bool* r_is_new) { \
+        uint64_t hashes[SET_BATCH_LENGTH]; \
+        for(list_uint start = 0; start < p_length; start += SET_BATCH_LENGTH) { \
+            const list_uint count = p_length - start < SET_BATCH_LENGTH? p_length - start: SET_BATCH_LENGTH; \
+            if(!mp_id ## _set_grow(p_set, count)) return false; \
+            const list_uint mask = p_set->capacity - 1; \
+            for(list_uint i = 0; i < count; i++) { \
+                hashes[i] = mp_hash(p_array[start + i]); \
+                LIST_PREFETCH(p_set->controls + ((hashes[i] >> 7) & mask)); \
+                LIST_PREFETCH(p_set->slots + ((hashes[i] >> 7) & mask)); \
+            } \
+            for(list_uint i = 0; i < count; i++) { \
+                list_uint slot = 0; \
+                const bool is_new = !mp_id ## _set_locate(p_set, p_array[start + i], hashes[i], &slot); \
+                if(is_new) mp_id ## _set_put(p_set, p_array[start + i], hashes[i]); \
+                if(r_is_new) r_is_new[start + i] = is_new; \
+            } \
+        } \
+        return true; \
+    } \
+    mp_keyword list_uint mp_id ## _set_contains_array(const struct mp_id ## _set* p_set, const mp_type* p_array, list_uint p_length, bool* r_results) { \
+        uint64_t hashes[SET_BATCH_LENGTH]; \
+        list_uint found = 0; \
+        const list_uint mask = p_set->capacity - 1; \
+        for(list_uint start = 0; start < p_length; start += SET_BATCH_LENGTH) { \
+            const list_uint count = p_length - start < SET_BATCH_LENGTH? p_length - start: SET_BATCH_LENGTH; \
+            for(list_uint i = 0; i < count; i++) { \
+                hashes[i] = mp_hash(p_array[start + i]); \
+                if(p_set->capacity) LIST_PREFETCH(p_set->controls + ((hashes[i] >> 7) & mask)); \
+            } \
+            for(list_uint i = 0; i < count; i++) { \
+                list_uint slot = 0; \
+                const bool result = mp_id ## _set_locate(p_set, p_array[start + i], hashes[i], &slot); \
+                found += result; \
+                if(r_results) r_results[start + i] = result; \
+            } \
+        } \
+        return found; \
+    }
+
+#endif //_SET_H_
@@ -0,0 +1,256 @@
+#ifndef _SORTED_LIST_H_
+#define _SORTED_LIST_H_
+
+/* # sorted_list
+ * This file contains macro for declaring and defining set operations on
+ * sorted lists of `list.h`: intersection, union, difference and k-way merge.
+ *
+ * ## Usage
+ * Declare & define the list with `list.h` (the structure and setter functions
+ * are needed), then declare & define the set operations with the macros of
+ * this file with the same `mp_id` & `mp_type`. `mp_type` must be comparable
+ * with `<` & `==`.
+ *
+ * The input lists must be sorted in non-decreasing order. Intersection, union
+ * & difference treat them as sets, so their items should be unique.
+ *
+ * ## Output
+ * Results are appended to the output list given, so results of many
+ * operations can be batched into one list. The output list is reserved once
+ * for the largest possible result before the operation, so it never grows in
+ * the inner loop. The output list must not be one of the input lists.
+ *
+ * ## Performance
+ * Lists of similar length are walked together with branch-free steps. When a
+ * list is more than `SORTED_LIST_GALLOP_RATIO` times longer than the other,
+ * the shorter one gallops (exponential then binary search) through the
+ * longer one instead. Inputs are prefetched `SORTED_LIST_PREFETCH_DISTANCE`
+ * items ahead. */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "list.h"
+
+#ifndef SORTED_LIST_GALLOP_RATIO
+#define SORTED_LIST_GALLOP_RATIO 32
+#endif //SORTED_LIST_GALLOP_RATIO
+
+#ifndef SORTED_LIST_PREFETCH_DISTANCE
+#define SORTED_LIST_PREFETCH_DISTANCE 64
+#endif //SORTED_LIST_PREFETCH_DISTANCE
+
+/* # Functions
+ * >> ID_list_intersect
+ *  Append the items in both lists.
+ *
+ * @param
+ *  `p_list_a` - First sorted list.
+ *  `p_list_b` - Second sorted list.
+ *
+ * @return
+ *  `r_list` - Output list.
+ *
+ * @error
+ *  | When the output length may be beyond `list_uint`, it fails.
+ *  | When fail to allocate an array, it fails.
+ *  % - `true` on success. `false` on fail.
+ * <<
+ * >> ID_list_union
+ *  Append the items in either list, sorted.
+ *
+ * @param
+ *  `p_list_a` - First sorted list.
+ *  `p_list_b` - Second sorted list.
+ *
+ * @return
+ *  `r_list` - Output list.
+ *
+ * @error
+ *  | When the output length may be beyond `list_uint`, it fails.
+ *  | When fail to allocate an array, it fails.
+ *  % - `true` on success. `false` on fail.
+ * <<
+ * >> ID_list_difference
+ *  Append the items in the first list but not the second.
+ *
+ * @param
+ *  `p_list_a` - First sorted list.
+ *  `p_list_b` - Second sorted list.
+ *
+ * @return
+ *  `r_list` - Output list.
+ *
+ * @error
+ *  | When the output length may be beyond `list_uint`, it fails.
+ *  | When fail to allocate an array, it fails.
+ *  % - `true` on success. `false` on fail.
+ * <<
+ * >> ID_list_merge
+ *  Append the items of all lists, sorted, with a tournament tree. Duplicates
+ *  are kept.
+ *
+ * @param
+ *  `p_lists` - Array of sorted lists.
+ *  `p_count` - Number of lists.
+ *
+ * @return
+ *  `r_list` - Output list.
+ *
+ * @error
+ *  | When the total length is beyond `list_uint`, it fails.
+ *  | When fail to allocate an array, it fails.
+ *  % - `true` on success. `false` on fail.
+ * <<
+ * */
+#define SORTED_LIST_DECLARE_FUNCTION(mp_id, mp_type, mp_keyword) \
+    mp_keyword bool mp_id ## _list_intersect(const struct mp_id ## _list* p_list_a, const struct mp_id ## _list* p_list_b, struct mp_id ## _list* r_list); \
+    mp_keyword bool mp_id ## _list_union(const struct mp_id ## _list* p_list_a, const struct mp_id ## _list* p_list_b, struct mp_id ## _list* r_list); \
+    mp_keyword bool mp_id ## _list_difference(const struct mp_id ## _list* p_list_a, const struct mp_id ## _list* p_list_b, struct mp_id ## _list* r_list); \
+    mp_keyword bool mp_id ## _list_merge(const struct mp_id ## _list* const* p_lists, list_uint p_count, struct mp_id ## _list* r_list);
+
+#define SORTED_LIST_DEFINE_FUNCTION(mp_id, mp_type, mp_keyword) \
+    /* First index not less than `p_item`, searching from `p_start`. */ \
+    static list_uint mp_id ## _list_gallop(const mp_type* p_items, list_uint p_length, list_uint p_start, const mp_type p_item) { \
+        if(p_start >= p_length || !(p_items[p_start] < p_item)) return p_start; \
+        list_uint low = p_start; \
+        uint64_t step = 1; \
+        while(step < p_length - low && p_items[low + step] < p_item) { \
+            low += step; \
+            step *= 2; \
+        } \
+        list_uint high = step < p_length - low? low + (list_uint)step: p_length; \
+        low++; \
+        while(low < high) { \
+            const list_uint middle = low + (high - low) / 2; \
+            if(p_items[middle] < p_item) low = middle + 1; \
+            else high = middle; \
+        } \
+        return low; \
+    } \
+    mp_keyword bool mp_id ## _list_intersect(const struct mp_id ## _list* p_list_a, const struct mp_id ## _list* p_list_b, struct mp_id ## _list* r_list) { \
+        const struct mp_id ## _list* small = p_list_a->length <= p_list_b->length? p_list_a: p_list_b; \
+        const struct mp_id ## _list* large = small == p_list_a? p_list_b: p_list_a; \
+        if(!small->length) return true; \
+        if((uint64_t)r_list->length + small->length > UINT32_MAX) return false; \
+        if(!mp_id ## _list_reserve(r_list, r_list->length + small->length)) return false; \
+        mp_type* output = r_list->items + r_list->length; \
+        list_uint length = 0; \
+        list_uint i = 0; \
+        list_uint j = 0; \
+        if((uint64_t)small->length * SORTED_LIST_GALLOP_RATIO < large->length) { \
+            for(; i < small->length; i++) { \
+                const mp_type item = small->items[i]; \
+                j = mp_id ## _list_gallop(large->items, large->length, j, item); \
+                if(j == large->length) break; \
+                output[length] = item; \
+                length += large->items[j] == item; \
+            } \
+        } else { \
+            while(i < small->length && j < large->length) { \
+                if(i + SORTED_LIST_PREFETCH_DISTANCE < small->length) LIST_PREFETCH(small->items + i + SORTED_LIST_PREFETCH_DISTANCE); \
+                if(j + SORTED_LIST_PREFETCH_DISTANCE < large->length) LIST_PREFETCH(large->items + j + SORTED_LIST_PREFETCH_DISTANCE); \
+                const mp_type item_a = small->items[i]; \
+                const mp_type item_b = large->items[j]; \
+                output[length] = item_a; \
+                length += item_a == item_b; \
+                i += !(item_b < item_a); \
+                j += !(item_a < item_b); \
+            } \
+        } \
+        r_list->length += length; \
+        return true; \
+    } \
+    mp_keyword bool mp_id ## _list_union(const struct mp_id ## _list* p_list_a, const struct mp_id ## _list* p_list_b, struct mp_id ## _list* r_list) { \
+        if(!p_list_a->length && !p_list_b->length) return true; \
+        if((uint64_t)r_list->length + p_list_a->length + p_list_b->length > UINT32_MAX) return false; \
+        if(!mp_id ## _list_reserve(r_list, r_list->length + p_list_a->length + p_list_b->length)) return false; \
+        mp_type* output = r_list->items + r_list->length; \
+        list_uint length = 0; \
+        list_uint i = 0; \
+        list_uint j = 0; \
+        while(i < p_list_a->length && j < p_list_b->length) { \
+            if(i + SORTED_LIST_PREFETCH_DISTANCE < p_list_a->length) LIST_PREFETCH(p_list_a->items + i + SORTED_LIST_PREFETCH_DISTANCE); \
+            if(j + SORTED_LIST_PREFETCH_DISTANCE < p_list_b->length) LIST_PREFETCH(p_list_b->items + j + SORTED_LIST_PREFETCH_DISTANCE); \
+            const mp_type item_a = p_list_a->items[i]; \
+            const mp_type item_b = p_list_b->items[j]; \
+            output[length++] = item_b < item_a? item_b: item_a; \
+            i += !(item_b < item_a); \
+            j += !(item_a < item_b); \
+        } \
+        if(i < p_list_a->length) memcpy(output + length, p_list_a->items + i, (p_list_a->length - i) * sizeof(mp_type)); \
+        length += p_list_a->length - i; \
+        if(j < p_list_b->length) memcpy(output + length, p_list_b->items + j, (p_list_b->length - j) * sizeof(mp_type)); \
+        length += p_list_b->length - j; \
+        r_list->length += length; \
+        return true; \
+    } \
+    mp_keyword bool mp_id ## _list_difference(const struct mp_id ## _list* p_list_a, const struct mp_id ## _list* p_list_b, struct mp_id ## _list* r_list) { \
+        if(!p_list_a->length) return true; \
+        if((uint64_t)r_list->length + p_list_a->length > UINT32_MAX) return false; \
+        if(!mp_id ## _list_reserve(r_list, r_list->length + p_list_a->length)) return false; \
+        mp_type* output = r_list->items + r_list->length; \
+        list_uint length = 0; \
+        list_uint i = 0; \
+        list_uint j = 0; \
+        if((uint64_t)p_list_a->length * SORTED_LIST_GALLOP_RATIO < p_list_b->length) { \
+            for(; i < p_list_a->length; i++) { \
+                const mp_type item = p_list_a->items[i]; \
+                j = mp_id ## _list_gallop(p_list_b->items, p_list_b->length, j, item); \
+                if(j == p_list_b->length) break; \
+                output[length] = item; \
+                length += !(p_list_b->items[j] == item); \
+            } \
+        } else { \
+            while(i < p_list_a->length && j < p_list_b->length) { \
+                if(i + SORTED_LIST_PREFETCH_DISTANCE < p_list_a->length) LIST_PREFETCH(p_list_a->items + i + SORTED_LIST_PREFETCH_DISTANCE); \
+                if(j + SORTED_LIST_PREFETCH_DISTANCE < p_list_b->length) LIST_PREFETCH(p_list_b->items + j + SORTED_LIST_PREFETCH_DISTANCE); \
+                const mp_type item_a = p_list_a->items[i]; \
+                const mp_type item_b = p_list_b->items[j]; \
+                output[length] = item_a; \
+                length += item_a < item_b; \
+                i += !(item_b < item_a); \
+                j += !(item_a < item_b); \
+            } \
+        } \
+        if(i < p_list_a->length) memcpy(output + length, p_list_a->items + i, (p_list_a->length - i) * sizeof(mp_type)); \
+        length += p_list_a->length - i; \
+        r_list->length += length; \
+        return true; \
+    } \
+    /* Winner of a match in the tournament tree, an exhausted list always loses. */ \
+    static list_uint mp_id ## _list_merge_winner(const struct mp_id ## _list* const* p_lists, const list_uint* p_cursors, list_uint p_a, list_uint p_b) { \
+        if(p_cursors[p_a] == p_lists[p_a]->length) return p_b; \
+        if(p_cursors[p_b] == p_lists[p_b]->length) return p_a; \
+        return p_lists[p_b]->items[p_cursors[p_b]] < p_lists[p_a]->items[p_cursors[p_a]]? p_b: p_a; \
+    } \
+    mp_keyword bool mp_id ## _list_merge(const struct mp_id ## _list* const* p_lists, list_uint p_count, struct mp_id ## _list* r_list) { \
+        uint64_t total = 0; \
+        for(list_uint i = 0; i < p_count; i++) total += p_lists[i]->length; \
+        if(!total) return true; \
+        if(r_list->length + total > UINT32_MAX) return false; \
+        if(!mp_id ## _list_reserve(r_list, r_list->length + (list_uint)total)) return false; \
+        /* Cursor per list, then the tree: node `n` has children `2n` & `2n + 1`, \
+         * list `i` is the leaf `p_count + i`. */ \
+        list_uint* cursors = LIST_CALLOC(3 * (size_t)p_count, sizeof(list_uint)); \
+        if(!cursors) return false; \
+        list_uint* tree = cursors + p_count; \
+        for(list_uint i = 0; i < p_count; i++) tree[p_count + i] = i; \
+        for(list_uint node = p_count - 1; node > 0; node--) \
+            tree[node] = mp_id ## _list_merge_winner(p_lists, cursors, tree[2 * node], tree[2 * node + 1]); \
+        mp_type* output = r_list->items + r_list->length; \
+        for(list_uint i = 0; i < total; i++) { \
+            const list_uint winner = tree[1]; \
+            const struct mp_id ## _list* list = p_lists[winner]; \
+            output[i] = list->items[cursors[winner]++]; \
+            if(cursors[winner] + SORTED_LIST_PREFETCH_DISTANCE < list->length) LIST_PREFETCH(list->items + cursors[winner] + SORTED_LIST_PREFETCH_DISTANCE); \
+            for(list_uint node = (p_count + winner) / 2; node > 0; node /= 2) \
+                tree[node] = mp_id ## _list_merge_winner(p_lists, cursors, tree[2 * node], tree[2 * node + 1]); \
+        } \
+        LIST_FREE(cursors); \
+        r_list->length += (list_uint)total; \
+        return true; \
+    }
+
+#endif //_SORTED_LIST_H_
@@ -0,0 +1,12 @@
+#include <list_common.h>
+
+/* Instantiations of the lists declared in `list_common.h`. */
+
+LIST_DEFINE_GETTER(int, int, )
+LIST_DEFINE_SETTER(int, int, )
+LIST_DEFINE_GETTER(uint64, uint64_t, )
+LIST_DEFINE_SETTER(uint64, uint64_t, )
+LIST_DEFINE_GETTER(double, double, )
+LIST_DEFINE_SETTER(double, double, )
+LIST_DEFINE_GETTER(ptr, list_ptr, )
+LIST_DEFINE_SETTER(ptr, list_ptr, )
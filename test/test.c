@@ -1,7 +1,23 @@
 #include <stdio.h>
 #include "test_list.h"
+#include "test_list_common.h"
+#include "test_packed_list.h"
+#include "test_concurrent_list.h"
+#include "test_set.h"
+#include "test_bloom.h"
+#include "test_pool.h"
+#include "test_sorted_list.h"
+#include "test_art.h"
 
 int main() {
     test_list();
+    test_list_common();
+    test_packed_list();
+    test_concurrent_list();
+    test_set();
+    test_bloom();
+    test_pool();
+    test_sorted_list();
+    test_art();
     return 0;
 }
@@ -0,0 +1,277 @@
+#include <art.h>
+#include <test.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "test_art.h"
+
+#define TEST_ART_LENGTH 1000
+
+ART_DEFINE(int, int, static);
+
+static void test_art_insert();
+static void test_art_get();
+static void test_art_erase();
+static void test_art_node();
+static void test_art_each_prefix();
+static void test_art_each_range();
+
+/* Key of the index, e.g. "/route/12/7", so the keys share long prefixes. */
+static list_uint test_art_key(int p_index, uint8_t* r_key) {
+    return (list_uint)sprintf((char*)r_key, "/route/%d/%d", p_index % 37, p_index);
+}
+
+static bool test_art_fill(struct int_art* r_art) {
+    uint8_t key[32];
+    bool result = true;
+    for(int i = 0; i < TEST_ART_LENGTH; i++) result &= int_art_insert(r_art, key, test_art_key(i, key), i, NULL);
+    return result;
+}
+
+/* Callback that checks the keys come in order, the context is the last key. */
+struct test_art_order {
+    uint8_t key[32];
+    list_uint length;
+    bool is_sorted;
+};
+
+static bool test_art_check_order(const uint8_t* p_key, list_uint p_length, int p_item, void* p_context) {
+    struct test_art_order* order = p_context;
+    uint8_t key[32];
+    const list_uint length = test_art_key(p_item, key);
+    if(length != p_length || memcmp(key, p_key, p_length)) order->is_sorted = false;
+    if(order->length && art_compare(order->key, order->length, p_key, p_length) >= 0) order->is_sorted = false;
+    memcpy(order->key, p_key, p_length);
+    order->length = p_length;
+    return true;
+}
+
+static bool test_art_stop(const uint8_t* p_key, list_uint p_length, int p_item, void* p_context) {
+    (void)p_key;
+    (void)p_length;
+    (void)p_item;
+    (void)p_context;
+    return false;
+}
+
+/* >> test_art
+ *  entrance for testing adaptive radix tree.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+void test_art() {
+    test_start("Test adaptive radix tree."); 
+    test_art_insert();
+    test_art_get();
+    test_art_erase();
+    test_art_node();
+    test_art_each_prefix();
+    test_art_each_range();
+    test_end();
+}
+
+/* >> test_art_insert
+ *  Test `ID_art_insert` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_art_insert() {
+    struct int_art art = {0};
+    bool result = test_art_fill(&art);
+    test(result && int_art_length(&art) == TEST_ART_LENGTH, "`ID_art_insert` with new keys.");
+    bool is_new = true;
+    result = int_art_insert(&art, (const uint8_t*)"/route/1/1", 10, -1, &is_new);
+    test(result && !is_new && int_art_length(&art) == TEST_ART_LENGTH, "`ID_art_insert` with existing key.");
+    result = int_art_insert(&art, (const uint8_t*)"/route/1", 8, -2, &is_new) && is_new;
+    result &= int_art_insert(&art, NULL, 0, -3, &is_new) && is_new;
+    test(result && int_art_length(&art) == TEST_ART_LENGTH + 2, "`ID_art_insert` with prefix of other keys.");
+    int_art_free_items(&art);
+}
+
+/* >> test_art_get
+ *  Test `ID_art_get` function.
+ *  This depends on `ID_art_insert` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_art_get() {
+    struct int_art art = {0};
+    uint8_t key[32];
+    int item = 0;
+    bool result = test_art_fill(&art);
+    for(int i = 0; i < TEST_ART_LENGTH; i++)
+        result &= int_art_get(&art, key, test_art_key(i, key), &item) && item == i;
+    test(result, "`ID_art_get` with existing keys.");
+    item = 0;
+    result = int_art_get(&art, (const uint8_t*)"/route/1", 8, &item);
+    result |= int_art_get(&art, (const uint8_t*)"/route/1/10", 11, &item);
+    result |= int_art_get(&art, (const uint8_t*)"/route/1/1/", 11, &item);
+    test(!result && item == 0, "`ID_art_get` with missing keys.");
+    int_art_insert(&art, (const uint8_t*)"/route/1", 8, -1, NULL);
+    result = int_art_get(&art, (const uint8_t*)"/route/1", 8, &item) && item == -1;
+    result &= int_art_get(&art, (const uint8_t*)"/route/1/1", 10, &item) && item == 1;
+    test(result, "`ID_art_get` with prefix of other keys.");
+    int_art_free_items(&art);
+}
+
+/* >> test_art_erase
+ *  Test `ID_art_erase` function.
+ *  This depends on `ID_art_insert` and `ID_art_get` functions.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_art_erase() {
+    struct int_art art = {0};
+    uint8_t key[32];
+    int item = 0;
+    test_art_fill(&art);
+    bool result = true;
+    for(int i = 0; i < TEST_ART_LENGTH; i += 2)
+        result &= int_art_erase(&art, key, test_art_key(i, key), &item) && item == i;
+    for(int i = 0; i < TEST_ART_LENGTH; i++)
+        result &= int_art_get(&art, key, test_art_key(i, key), NULL) == (i % 2);
+    test(result && int_art_length(&art) == TEST_ART_LENGTH / 2, "`ID_art_erase` with existing keys.");
+    result = int_art_erase(&art, key, test_art_key(0, key), NULL);
+    result |= int_art_erase(&art, (const uint8_t*)"/route/1", 8, NULL);
+    test(!result && int_art_length(&art) == TEST_ART_LENGTH / 2, "`ID_art_erase` with missing keys.");
+    for(int i = 1; i < TEST_ART_LENGTH; i += 2) int_art_erase(&art, key, test_art_key(i, key), NULL);
+    result = !art.root && !art.node4_pool.length && !art.node16_pool.length && !art.node48_pool.length && !art.node256_pool.length;
+    test(result && int_art_length(&art) == 0, "`ID_art_erase` with every key.");
+    int_art_free_items(&art);
+}
+
+/* >> test_art_node
+ *  Test growing & shrinking through every node size.
+ *  This depends on `ID_art_insert`, `ID_art_get` and `ID_art_erase`
+ *  functions.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_art_node() {
+    struct int_art art = {0};
+    uint8_t key[2] = {'k', 0};
+    bool result = true;
+    for(int i = 255; i >= 0; i--) {
+        key[1] = (uint8_t)i;
+        result &= int_art_insert(&art, key, 2, i, NULL);
+    }
+    test(result && art.root && art.root->type == ART_NODE256, "Growing into node256.");
+    int item = 0;
+    for(int i = 0; i < 256; i++) {
+        key[1] = (uint8_t)i;
+        result &= int_art_get(&art, key, 2, &item) && item == i;
+    }
+    test(result, "`ID_art_get` with node256.");
+    uint8_t types = 0;
+    for(int i = 0; i < 255; i++) {
+        key[1] = (uint8_t)i;
+        result &= int_art_erase(&art, key, 2, NULL);
+        if(art.root && !int_art_is_leaf(art.root)) types |= 1 << art.root->type;
+        if(i == 230) {
+            for(int j = 0; j < 256; j++) {
+                key[1] = (uint8_t)j;
+                result &= int_art_get(&art, key, 2, &item) == (j > i);
+            }
+        }
+    }
+    key[1] = 255;
+    result &= int_art_get(&art, key, 2, &item) && item == 255;
+    test(result && types == 0xF && int_art_is_leaf(art.root), "Shrinking from node256.");
+    int_art_free_items(&art);
+}
+
+/* >> test_art_each_prefix
+ *  Test `ID_art_each_prefix` function.
+ *  This depends on `ID_art_insert` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_art_each_prefix() {
+    struct int_art art = {0};
+    struct test_art_order order = {.is_sorted = true};
+    test_art_fill(&art);
+    list_uint count = int_art_each_prefix(&art, NULL, 0, test_art_check_order, &order);
+    test(count == TEST_ART_LENGTH && order.is_sorted, "`ID_art_each_prefix` with empty prefix.");
+    order = (struct test_art_order){.is_sorted = true};
+    count = int_art_each_prefix(&art, (const uint8_t*)"/route/3/", 9, test_art_check_order, &order);
+    test(count == (TEST_ART_LENGTH - 3 + 36) / 37 && order.is_sorted, "`ID_art_each_prefix` with shared prefix.");
+    order = (struct test_art_order){.is_sorted = true};
+    count = int_art_each_prefix(&art, (const uint8_t*)"/route/3", 8, test_art_check_order, &order);
+    list_uint expected = 0;
+    for(int i = 0; i < TEST_ART_LENGTH; i++) expected += i % 37 == 3 || i % 37 >= 30;
+    test(count == expected && order.is_sorted, "`ID_art_each_prefix` with prefix shared by several routes.");
+    count = int_art_each_prefix(&art, (const uint8_t*)"/rout/", 6, test_art_check_order, &order);
+    count += int_art_each_prefix(&art, (const uint8_t*)"/route/3/3/", 11, test_art_check_order, &order);
+    test(count == 0, "`ID_art_each_prefix` with missing prefix.");
+    count = int_art_each_prefix(&art, NULL, 0, test_art_stop, NULL);
+    test(count == 1, "`ID_art_each_prefix` stopped by callback.");
+    int_art_free_items(&art);
+}
+
+/* >> test_art_each_range
+ *  Test `ID_art_each_range` function.
+ *  This depends on `ID_art_insert` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_art_each_range() {
+    struct int_art art = {0};
+    struct test_art_order order = {.is_sorted = true};
+    uint8_t low[32];
+    uint8_t high[32];
+    test_art_fill(&art);
+    const list_uint low_length = test_art_key(37 * 5 + 2, low);
+    const list_uint high_length = test_art_key(37 * 20 + 2, high);
+    list_uint expected = 0;
+    for(int i = 0; i < TEST_ART_LENGTH; i++) {
+        uint8_t key[32];
+        const list_uint length = test_art_key(i, key);
+        expected += art_compare(key, length, low, low_length) >= 0 && art_compare(key, length, high, high_length) < 0;
+    }
+    list_uint count = int_art_each_range(&art, low, low_length, high, high_length, test_art_check_order, &order);
+    test(count == expected && order.is_sorted, "`ID_art_each_range` with both bounds.");
+    order = (struct test_art_order){.is_sorted = true};
+    count = int_art_each_range(&art, NULL, 0, NULL, 0, test_art_check_order, &order);
+    test(count == TEST_ART_LENGTH && order.is_sorted, "`ID_art_each_range` without bounds.");
+    count = int_art_each_range(&art, (const uint8_t*)"/route/1/", 9, (const uint8_t*)"/route/1/1", 10, test_art_check_order, &order);
+    count += int_art_each_range(&art, high, high_length, low, low_length, test_art_check_order, &order);
+    test(count == 0, "`ID_art_each_range` with empty range.");
+    count = int_art_each_range(&art, (const uint8_t*)"/route/1/1", 10, (const uint8_t*)"/route/1/1", 11, test_art_check_order, &order);
+    test(count == 1, "`ID_art_each_range` with a single key.");
+    int_art_free_items(&art);
+}
@@ -0,0 +1,6 @@
+#ifndef _TEST_ART_H_
+#define _TEST_ART_H_
+
+void test_art(); 
+
+#endif //_TEST_ART_H_
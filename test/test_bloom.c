@@ -0,0 +1,107 @@
+#include <bloom.h>
+#include <set.h>
+#include <test.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "test_bloom.h"
+
+#define TEST_BLOOM_LENGTH 10000
+#define TEST_BLOOM_RATE 0.01
+/* Expected false positives per tested rate, enough to measure the rate. */
+#define TEST_BLOOM_POSITIVE 400
+
+static void test_bloom_contains();
+static void test_bloom_contains_array();
+static void test_bloom_init();
+
+/* >> test_bloom
+ *  entrance for testing bloom filter.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+void test_bloom() {
+    test_start("Test bloom."); 
+    test_bloom_contains();
+    test_bloom_contains_array();
+    test_bloom_init();
+    test_end();
+}
+
+/* >> test_bloom_contains
+ *  Test `bloom_insert` & `bloom_contains` functions. There must be no false
+ *  negative, and false positive must be near the rate requested, for every
+ *  tested rate.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_bloom_contains() {
+    const double rates[] = {0.01, 0.001, 0.0001};
+    bool is_contained = true;
+    bool is_accurate = true;
+    for(list_uint i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+        struct bloom bloom = {0};
+        const uint64_t query_count = (uint64_t)(TEST_BLOOM_POSITIVE / rates[i]);
+        uint64_t positive = 0;
+        is_contained &= bloom_init(&bloom, TEST_BLOOM_LENGTH, rates[i]);
+        for(uint64_t j = 0; j < TEST_BLOOM_LENGTH; j++) bloom_insert(&bloom, set_hash_integer(j));
+        for(uint64_t j = 0; j < TEST_BLOOM_LENGTH; j++) is_contained &= bloom_contains(&bloom, set_hash_integer(j));
+        for(uint64_t j = TEST_BLOOM_LENGTH; j < TEST_BLOOM_LENGTH + query_count; j++) positive += bloom_contains(&bloom, set_hash_integer(j));
+        is_accurate &= positive < TEST_BLOOM_POSITIVE * 1.25;
+        bloom_free(&bloom);
+    }
+    test(is_contained, "`bloom_contains` with inserted items.");
+    test(is_accurate, "`bloom_contains` false positive rate.");
+}
+
+/* >> test_bloom_contains_array
+ *  Test `bloom_insert_array` & `bloom_contains_array` functions.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_bloom_contains_array() {
+    uint64_t hashes[TEST_BLOOM_LENGTH];
+    bool results[TEST_BLOOM_LENGTH];
+    struct bloom bloom = {0};
+    bool result = bloom_init(&bloom, TEST_BLOOM_LENGTH, TEST_BLOOM_RATE);
+    for(uint64_t i = 0; i < TEST_BLOOM_LENGTH; i++) hashes[i] = set_hash_integer(i);
+    bloom_insert_array(&bloom, hashes, TEST_BLOOM_LENGTH);
+    result &= bloom_contains_array(&bloom, hashes, TEST_BLOOM_LENGTH, results) == TEST_BLOOM_LENGTH;
+    for(list_uint i = 0; i < TEST_BLOOM_LENGTH; i++) result &= results[i];
+    test(result, "`bloom_contains_array`.");
+    bloom_free(&bloom);
+}
+
+/* >> test_bloom_init
+ *  Test `bloom_init` function with rates out of range.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_bloom_init() {
+    const double rates[] = {0, 1, 2, -0.5, NAN};
+    struct bloom bloom = {0};
+    bool result = true;
+    for(list_uint i = 0; i < sizeof(rates) / sizeof(rates[0]); i++)
+        result &= !bloom_init(&bloom, TEST_BLOOM_LENGTH, rates[i]) && !bloom.block_count && !bloom.words;
+    test(result, "`bloom_init` with rate out of range.");
+    bloom_free(&bloom);
+}
@@ -0,0 +1,6 @@
+#ifndef _TEST_BLOOM_H_
+#define _TEST_BLOOM_H_
+
+void test_bloom(); 
+
+#endif //_TEST_BLOOM_H_
@@ -0,0 +1,193 @@
+#include <concurrent_list.h>
+#include <list.h>
+#include <test.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <pthread.h>
+#include "test_concurrent_list.h"
+
+#define TEST_CONCURRENT_LIST_THREAD_COUNT 4
+#define TEST_CONCURRENT_LIST_LENGTH 10000
+#define TEST_CONCURRENT_LIST_ARRAY_LENGTH 10
+
+LIST_DEFINE_STRUCT(int, int, );
+LIST_DEFINE_GETTER(int, int, static inline);
+LIST_DEFINE_SETTER(int, int, static inline);
+
+CONCURRENT_LIST_DEFINE_STRUCT(int, int, );
+CONCURRENT_LIST_DEFINE_WRITER(int, int, static inline);
+CONCURRENT_LIST_DEFINE_READER(int, int, static inline);
+CONCURRENT_LIST_DEFINE_CONVERTER(int, int, static inline);
+
+struct test_concurrent_list_writer {
+    pthread_t thread;
+    struct int_concurrent_list* list;
+    int first;
+    bool result;
+};
+
+static void test_concurrent_list_append();
+static void test_concurrent_list_seal();
+static void test_concurrent_list_to_list();
+
+/* >> test_concurrent_list
+ *  entrance for testing concurrent list.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+void test_concurrent_list() {
+    test_start("Test concurrent list."); 
+    test_concurrent_list_append();
+    test_concurrent_list_seal();
+    test_concurrent_list_to_list();
+    test_end();
+}
+
+/* Writer thread, appends its own range of items, half one by one and half as
+ * arrays. */
+static void* test_concurrent_list_write(void* p_writer) {
+    struct test_concurrent_list_writer* writer = p_writer;
+    int array[TEST_CONCURRENT_LIST_ARRAY_LENGTH];
+    writer->result = true;
+    for(int i = 0; i < TEST_CONCURRENT_LIST_LENGTH / 2; i++)
+        writer->result &= int_concurrent_list_append(writer->list, writer->first + i);
+    for(int i = TEST_CONCURRENT_LIST_LENGTH / 2; i < TEST_CONCURRENT_LIST_LENGTH; i += TEST_CONCURRENT_LIST_ARRAY_LENGTH) {
+        for(int j = 0; j < TEST_CONCURRENT_LIST_ARRAY_LENGTH; j++) array[j] = writer->first + i + j;
+        writer->result &= int_concurrent_list_append_array(writer->list, array, TEST_CONCURRENT_LIST_ARRAY_LENGTH);
+    }
+    return NULL;
+}
+
+/* Fill the list from `TEST_CONCURRENT_LIST_THREAD_COUNT` threads. */
+static bool test_concurrent_list_fill(struct int_concurrent_list* p_list) {
+    struct test_concurrent_list_writer writers[TEST_CONCURRENT_LIST_THREAD_COUNT];
+    bool result = true;
+    for(int i = 0; i < TEST_CONCURRENT_LIST_THREAD_COUNT; i++) {
+        writers[i].list = p_list;
+        writers[i].first = i * TEST_CONCURRENT_LIST_LENGTH;
+        pthread_create(&writers[i].thread, NULL, test_concurrent_list_write, writers + i);
+    }
+    for(int i = 0; i < TEST_CONCURRENT_LIST_THREAD_COUNT; i++) {
+        pthread_join(writers[i].thread, NULL);
+        result &= writers[i].result;
+    }
+    return result;
+}
+
+/* >> test_concurrent_list_append
+ *  Test `ID_concurrent_list_append` & `ID_concurrent_list_append_array`
+ *  functions from many threads. Every item must be stored exactly once and
+ *  each array must stay consecutive.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_concurrent_list_append() {
+    const list_uint length = TEST_CONCURRENT_LIST_THREAD_COUNT * TEST_CONCURRENT_LIST_LENGTH;
+    struct int_concurrent_list* list = int_concurrent_list_new();
+    bool* is_seen = calloc(length, sizeof(bool));
+    bool result = test_concurrent_list_fill(list) && int_concurrent_list_seal(list);
+    int item = 0;
+    int next = 0;
+
+    result &= int_concurrent_list_length(list) == length;
+    for(list_uint i = 0; result && i < length; i++) {
+        result &= int_concurrent_list_get(list, i, &item) && !is_seen[item];
+        is_seen[item] = true;
+        if(item % TEST_CONCURRENT_LIST_LENGTH >= TEST_CONCURRENT_LIST_LENGTH / 2) {
+            if(item % TEST_CONCURRENT_LIST_ARRAY_LENGTH) result &= item == next;
+            next = item + 1;
+        }
+    }
+    test(result, "`ID_concurrent_list_append` from many threads.");
+
+    free(is_seen);
+    int_concurrent_list_free(list);
+}
+
+/* >> test_concurrent_list_seal
+ *  Test `ID_concurrent_list_seal` function with reserved slots.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_concurrent_list_seal() {
+    struct int_concurrent_list list = {0};
+    list_uint index = 0;
+    int item = 0;
+    bool result = false;
+
+    int_concurrent_list_append(&list, 1);
+    int_concurrent_list_reserve(&list, 2, &index);
+    *int_concurrent_list_slot(&list, index) = 2;
+    result = int_concurrent_list_seal(&list);
+    test(!result && !int_concurrent_list_get(&list, 0, &item), "`ID_concurrent_list_seal` with uncommitted slots.");
+
+    *int_concurrent_list_slot(&list, index + 1) = 3;
+    int_concurrent_list_commit(&list, 2);
+    result = int_concurrent_list_reserve(&list, UINT32_MAX, &index);
+    test(!result && atomic_load(&list.reserved) == 3, "`ID_concurrent_list_reserve` beyond `list_uint`.");
+    result = int_concurrent_list_seal(&list);
+    test(result && int_concurrent_list_get(&list, 2, &item) && item == 3, "`ID_concurrent_list_seal` with committed slots.");
+
+    result = int_concurrent_list_append(&list, 4);
+    test(!result && int_concurrent_list_length(&list) == 3, "`ID_concurrent_list_append` on sealed list.");
+
+    int_concurrent_list_free_items(&list);
+}
+
+/* >> test_concurrent_list_to_list
+ *  Test `ID_concurrent_list_to_list` & `ID_concurrent_list_segment` functions.
+ *  This depends on `ID_concurrent_list_append_array` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_concurrent_list_to_list() {
+    int array[TEST_CONCURRENT_LIST_LENGTH];
+    struct int_concurrent_list concurrent_list = {0};
+    struct int_list list_a = {0};
+    struct int_list list_b = {0};
+    const int* items = NULL;
+    list_uint length = 0;
+    list_uint total = 0;
+    bool result = false;
+    for(int i = 0; i < TEST_CONCURRENT_LIST_LENGTH; i++) array[i] = i;
+    int_list_from_array(array, TEST_CONCURRENT_LIST_LENGTH, &list_a);
+    int_concurrent_list_append_array(&concurrent_list, array, TEST_CONCURRENT_LIST_LENGTH);
+
+    result = int_concurrent_list_to_list(&concurrent_list, &list_b);
+    test(!result, "`ID_concurrent_list_to_list` on unsealed list.");
+
+    int_concurrent_list_seal(&concurrent_list);
+    result = int_concurrent_list_to_list(&concurrent_list, &list_b);
+    test(result && int_list_equal(&list_a, &list_b), "`ID_concurrent_list_to_list` on sealed list.");
+
+    result = true;
+    for(list_uint i = 0; int_concurrent_list_segment(&concurrent_list, i, &items, &length); i++) {
+        result &= !memcmp(items, array + total, length * sizeof(int));
+        total += length;
+    }
+    test(result && total == TEST_CONCURRENT_LIST_LENGTH, "`ID_concurrent_list_segment`.");
+
+    int_concurrent_list_free_items(&concurrent_list);
+    int_list_free_items(&list_a);
+    int_list_free_items(&list_b);
+}
@@ -0,0 +1,6 @@
+#ifndef _TEST_CONCURRENT_LIST_H_
+#define _TEST_CONCURRENT_LIST_H_
+
+void test_concurrent_list(); 
+
+#endif //_TEST_CONCURRENT_LIST_H_
@@ -19,6 +19,7 @@ static void print_list(struct int_list* p_list) {
 
 static void test_list_from_array();
 static void test_list_equal();
+static void test_list_reserve();
 static void test_list_get();
 static void test_list_length();
 static void test_list_find();
@@ -44,6 +45,7 @@ void test_list() {
     test_start("Test list."); 
     test_list_from_array();
     test_list_equal();
+    test_list_reserve();
     test_list_get(); 
     test_list_length(); 
     test_list_find(); 
@@ -73,6 +75,9 @@ static void test_list_from_array() {
     int_list_from_array(array, ARRAY_LEN(array), &list); 
     test(!memcmp(array, list.items, sizeof(array)), "`ID_list_from_array`");
     int_list_free_items(&list); 
+    list = (struct int_list){0};
+    test(int_list_from_array(array, 0, &list) && list.length == 0, "`ID_list_from_array` with empty array.");
+    int_list_free_items(&list); 
 }
 
 /* >> test_list_equal
@@ -99,6 +104,33 @@ static void test_list_equal() {
     int_list_free_items(&list_a); 
     int_list_free_items(&list_b);
 }
+
+/* >> test_list_reserve
+ *  Test `ID_list_reserve` function.
+ *  This depends on `ID_list_append` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_list_reserve() {
+    struct int_list list = {0};
+    bool result = false;
+    int* items = NULL;
+
+    result = int_list_reserve(&list, 100);
+    test(result && list.capacity >= 100 && list.length == 0, "`ID_list_reserve` on empty list.");
+
+    items = list.items;
+    for(int i = 0; i < 100; i++) int_list_append(&list, i);
+    result = int_list_reserve(&list, 50);
+    test(result && list.items == items && list.length == 100, "`ID_list_reserve` within capacity.");
+
+    int_list_free_items(&list);
+}
 /* >> test_list_get
  *  Test `ID_list_get` function.
  *  This depends on `ID_list_from_array` function.
@@ -232,6 +264,9 @@ static void test_list_insert() {
     test(result && int_list_equal(&list_a, &list_b), "`ID_list_insert` with valid index."); 
     result = int_list_set(&list_a, 2, 20);
     test(!result && int_list_equal(&list_a, &list_b), "`ID_list_insert` with invalid index."); 
+    struct int_list list_full = {.length = UINT32_MAX, .capacity = UINT32_MAX};
+    result = int_list_insert(&list_full, 6, UINT32_MAX);
+    test(!result && list_full.capacity == UINT32_MAX, "`ID_list_insert` into full list.");
 
     int_list_free_items(&list_a);
     int_list_free_items(&list_b);
@@ -0,0 +1,54 @@
+#include <list_common.h>
+#include <test.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "test_list_common.h"
+
+#define ARRAY_LEN(p_array) (sizeof(p_array) / sizeof(p_array[0]))
+
+/* >> test_list_common
+ *  entrance for testing the precompiled lists of `libstruct`.
+ *  The list functions are tested in `test_list`, this only checks that every
+ *  instantiation links and behaves.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+void test_list_common() {
+    const int int_array[] = {1, 2, 3};
+    const uint64_t uint64_array[] = {UINT64_MAX, 0, 42};
+    const double double_array[] = {0.5, 1.5, 2.5};
+    list_ptr ptr_array[] = {NULL, (void*)int_array, (void*)double_array};
+    struct int_list* int_list = int_list_new();
+    struct uint64_list uint64_list = {0};
+    struct double_list double_list = {0};
+    struct ptr_list ptr_list = {0};
+    list_uint index = 0;
+    uint64_t uint64_item = 0;
+    double double_item = 0;
+
+    test_start("Test list common."); 
+
+    int_list_from_array(int_array, ARRAY_LEN(int_array), int_list);
+    test(int_list_append(int_list, 4) && int_list_length(int_list) == 4, "`int_list`");
+
+    uint64_list_from_array(uint64_array, ARRAY_LEN(uint64_array), &uint64_list);
+    test(uint64_list_get(&uint64_list, 0, &uint64_item) && uint64_item == UINT64_MAX, "`uint64_list`");
+
+    double_list_from_array(double_array, ARRAY_LEN(double_array), &double_list);
+    test(double_list_pop_front(&double_list, &double_item) && double_item == 0.5, "`double_list`");
+
+    ptr_list_from_array(ptr_array, ARRAY_LEN(ptr_array), &ptr_list);
+    test(ptr_list_find(&ptr_list, (void*)double_array, 0, &index) && index == 2, "`ptr_list`");
+
+    test_end();
+
+    int_list_free(int_list);
+    uint64_list_free_items(&uint64_list);
+    double_list_free_items(&double_list);
+    ptr_list_free_items(&ptr_list);
+}
@@ -0,0 +1,6 @@
+#ifndef _TEST_LIST_COMMON_H_
+#define _TEST_LIST_COMMON_H_
+
+void test_list_common(); 
+
+#endif //_TEST_LIST_COMMON_H_
@@ -0,0 +1,232 @@
+#include <packed_list.h>
+#include <list.h>
+#include <test.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "test_packed_list.h"
+
+#define TEST_PACKED_LIST_LENGTH 1000
+
+LIST_DEFINE_STRUCT(u32, uint32_t, );
+LIST_DEFINE_GETTER(u32, uint32_t, static inline);
+LIST_DEFINE_SETTER(u32, uint32_t, static inline);
+
+PACKED_LIST_DEFINE_STRUCT(u32, uint32_t, );
+PACKED_LIST_DEFINE_GETTER(u32, uint32_t, static inline);
+PACKED_LIST_DEFINE_SETTER(u32, uint32_t, static inline);
+PACKED_LIST_DEFINE_CONVERTER(u32, u32, static inline);
+
+PACKED_LIST_DEFINE_STRUCT(u64, uint64_t, );
+PACKED_LIST_DEFINE_GETTER(u64, uint64_t, static inline);
+PACKED_LIST_DEFINE_SETTER(u64, uint64_t, static inline);
+
+static void test_packed_list_append();
+static void test_packed_list_get();
+static void test_packed_list_seek();
+static void test_packed_list_to_list();
+static void test_packed_list_footprint();
+static void test_packed_list_width();
+
+/* Sorted items with irregular gaps, every item appears twice. */
+static uint32_t test_packed_list_item(list_uint p_index) {
+    const list_uint pair = p_index / 2;
+    return pair * 9 + (pair % 5) * (pair % 3); 
+}
+
+/* >> test_packed_list
+ *  entrance for testing packed list.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+void test_packed_list() {
+    test_start("Test packed list."); 
+    test_packed_list_append();
+    test_packed_list_get();
+    test_packed_list_seek();
+    test_packed_list_to_list();
+    test_packed_list_footprint();
+    test_packed_list_width();
+    test_end();
+}
+
+static void test_packed_list_fill(struct u32_packed_list* r_list) {
+    for(list_uint i = 0; i < TEST_PACKED_LIST_LENGTH; i++)
+        u32_packed_list_append(r_list, test_packed_list_item(i));
+}
+
+/* >> test_packed_list_append
+ *  Test `ID_packed_list_append` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_packed_list_append() {
+    struct u32_packed_list* list = u32_packed_list_new();
+    bool result = true;
+    for(list_uint i = 0; i < TEST_PACKED_LIST_LENGTH; i++)
+        result &= u32_packed_list_append(list, test_packed_list_item(i));
+    test(result && u32_packed_list_length(list) == TEST_PACKED_LIST_LENGTH, "`ID_packed_list_append` with sorted items.");
+    result = u32_packed_list_append(list, 0);
+    test(!result && u32_packed_list_length(list) == TEST_PACKED_LIST_LENGTH, "`ID_packed_list_append` with unsorted item.");
+    u32_packed_list_free(list);
+}
+
+/* >> test_packed_list_get
+ *  Test `ID_packed_list_get` function, on both packed blocks and tail.
+ *  This depends on `ID_packed_list_append` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_packed_list_get() {
+    struct u32_packed_list list = {0};
+    uint32_t item = 0;
+    bool result = true;
+    test_packed_list_fill(&list);
+    for(list_uint i = 0; i < TEST_PACKED_LIST_LENGTH; i++)
+        result &= u32_packed_list_get(&list, i, &item) && item == test_packed_list_item(i);
+    test(result, "`ID_packed_list_get` with valid index.");
+    item = 0;
+    result = u32_packed_list_get(&list, TEST_PACKED_LIST_LENGTH, &item);
+    test(!result && item == 0, "`ID_packed_list_get` with invalid index.");
+    u32_packed_list_free_items(&list);
+}
+
+/* >> test_packed_list_seek
+ *  Test `ID_packed_list_seek` function.
+ *  This depends on `ID_packed_list_append` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_packed_list_seek() {
+    struct u32_packed_list list = {0};
+    list_uint index = 0;
+    bool result = true;
+    test_packed_list_fill(&list);
+
+    for(list_uint i = 0; i < TEST_PACKED_LIST_LENGTH; i++) {
+        const uint32_t item = test_packed_list_item(i);
+        list_uint expected = i;
+        while(expected && test_packed_list_item(expected - 1) >= item) expected--;
+        result &= u32_packed_list_seek(&list, item, &index) && index == expected;
+    }
+    test(result, "`ID_packed_list_seek` with existing item.");
+
+    result = u32_packed_list_seek(&list, test_packed_list_item(301) + 1, &index);
+    test(result && index == 302, "`ID_packed_list_seek` with non-existing item.");
+
+    index = 0;
+    result = u32_packed_list_seek(&list, UINT32_MAX, &index);
+    test(!result && index == 0, "`ID_packed_list_seek` with item beyond the last.");
+
+    u32_packed_list_free_items(&list);
+}
+
+/* >> test_packed_list_to_list
+ *  Test `ID_packed_list_to_list` function.
+ *  This depends on `ID_packed_list_append` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_packed_list_to_list() {
+    struct u32_packed_list packed_list = {0};
+    struct u32_list list_a = {0};
+    struct u32_list list_b = {0};
+    bool result = false;
+    test_packed_list_fill(&packed_list);
+    for(list_uint i = 0; i < TEST_PACKED_LIST_LENGTH; i++)
+        u32_list_append(&list_a, test_packed_list_item(i));
+
+    result = u32_packed_list_to_list(&packed_list, &list_b);
+    test(result && u32_list_equal(&list_a, &list_b), "`ID_packed_list_to_list`.");
+
+    u32_packed_list_free_items(&packed_list);
+    u32_list_free_items(&list_a);
+    u32_list_free_items(&list_b);
+}
+
+/* >> test_packed_list_footprint
+ *  Test that dense sorted items are compressed.
+ *  This depends on `ID_packed_list_append` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_packed_list_footprint() {
+    struct u32_packed_list list = {0};
+    const list_uint length = 64 * PACKED_LIST_BLOCK_LENGTH;
+    for(list_uint i = 0; i < length; i++) u32_packed_list_append(&list, i * 3);
+    test(u32_packed_list_footprint(&list) * 3 < length * sizeof(uint32_t), "`ID_packed_list_footprint` with dense items.");
+    u32_packed_list_free_items(&list);
+}
+
+/* >> test_packed_list_width
+ *  Test packing of deltas of every width, up to 64 bits.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_packed_list_width() {
+    struct u64_packed_list list = {0};
+    uint64_t item = 0;
+    list_uint index = 0;
+    bool result = true;
+    u64_packed_list_append(&list, 0);
+    for(list_uint i = 1; i < PACKED_LIST_BLOCK_LENGTH; i++) u64_packed_list_append(&list, UINT64_MAX - PACKED_LIST_BLOCK_LENGTH + i);
+    u64_packed_list_append(&list, UINT64_MAX);
+    for(list_uint i = 1; i < PACKED_LIST_BLOCK_LENGTH; i++)
+        result &= u64_packed_list_get(&list, i, &item) && item == UINT64_MAX - PACKED_LIST_BLOCK_LENGTH + i;
+    result &= u64_packed_list_seek(&list, 1, &index) && index == 1;
+    test(result, "`ID_packed_list_get` with 64 bits wide delta.");
+    u64_packed_list_free_items(&list);
+
+    result = true;
+    for(uint8_t width = 1; width < 64; width++) {
+        uint64_t expected[PACKED_LIST_BLOCK_LENGTH + 1] = {0};
+        list = (struct u64_packed_list){0};
+        u64_packed_list_append(&list, 0);
+        for(list_uint i = 1; i <= PACKED_LIST_BLOCK_LENGTH; i++) {
+            /* One delta of the full width, the others scattered below it. */
+            const uint64_t delta = i == PACKED_LIST_BLOCK_LENGTH / 2? (UINT64_MAX >> (64 - width)):
+                ((i * 0x9E3779B97F4A7C15u) >> (64 - width)) >> 7;
+            expected[i] = expected[i - 1] + delta;
+            u64_packed_list_append(&list, expected[i]);
+        }
+        u64_packed_list_append(&list, expected[PACKED_LIST_BLOCK_LENGTH]);
+        for(list_uint i = 0; i <= PACKED_LIST_BLOCK_LENGTH; i++)
+            result &= u64_packed_list_get(&list, i, &item) && item == expected[i];
+        u64_packed_list_free_items(&list);
+    }
+    test(result, "`ID_packed_list_get` with deltas of every width.");
+}
@@ -0,0 +1,6 @@
+#ifndef _TEST_PACKED_LIST_H_
+#define _TEST_PACKED_LIST_H_
+
+void test_packed_list(); 
+
+#endif //_TEST_PACKED_LIST_H_
@@ -0,0 +1,209 @@
+#define LIST_HEADER_ALLOC(mp_id) mp_id ## _list_pool_alloc(&mp_id ## _list_pool)
+#define LIST_HEADER_FREE(mp_id, mp_list) mp_id ## _list_pool_release(&mp_id ## _list_pool, mp_list)
+#include <list.h>
+#include <pool.h>
+#include <test.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <pthread.h>
+#include "test_pool.h"
+
+#define TEST_POOL_LENGTH 1000
+#define TEST_POOL_THREAD_COUNT 4
+
+struct test_pool_node {
+    struct test_pool_node* next;
+    int value;
+};
+
+POOL_DEFINE(node, struct test_pool_node, static inline);
+
+LIST_DEFINE_STRUCT(int, int, );
+POOL_DEFINE(int_list, struct int_list, static inline);
+static struct int_list_pool int_list_pool = {0};
+LIST_DEFINE_GETTER(int, int, static inline);
+LIST_DEFINE_SETTER(int, int, static inline);
+
+static void test_pool_alloc();
+static void test_pool_release_array();
+static void test_pool_clear();
+static void test_pool_cache();
+static void test_pool_list();
+
+/* >> test_pool
+ *  entrance for testing pool.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+void test_pool() {
+    test_start("Test pool."); 
+    test_pool_alloc();
+    test_pool_release_array();
+    test_pool_clear();
+    test_pool_cache();
+    test_pool_list();
+    test_end();
+}
+
+/* >> test_pool_alloc
+ *  Test `ID_pool_alloc` & `ID_pool_release` functions.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_pool_alloc() {
+    struct node_pool pool = {0};
+    struct test_pool_node* nodes[TEST_POOL_LENGTH];
+    bool result = true;
+    for(int i = 0; i < TEST_POOL_LENGTH; i++) {
+        nodes[i] = node_pool_alloc(&pool);
+        result &= nodes[i] != NULL;
+        if(nodes[i]) nodes[i]->value = i;
+    }
+    for(int i = 0; i < TEST_POOL_LENGTH; i++) result &= nodes[i]->value == i;
+    test(result && pool.length == TEST_POOL_LENGTH, "`ID_pool_alloc` across slabs.");
+
+    struct test_pool_node* released = nodes[TEST_POOL_LENGTH / 2];
+    node_pool_release(&pool, released);
+    result = node_pool_alloc(&pool) == released;
+    test(result && pool.length == TEST_POOL_LENGTH, "`ID_pool_release` then `ID_pool_alloc` reuses the object.");
+
+    node_pool_free_items(&pool);
+}
+
+/* >> test_pool_release_array
+ *  Test `ID_pool_release_array` function.
+ *  This depends on `ID_pool_alloc` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_pool_release_array() {
+    struct node_pool pool = {0};
+    struct test_pool_node* nodes[TEST_POOL_LENGTH];
+    bool result = true;
+    for(int i = 0; i < TEST_POOL_LENGTH; i++) nodes[i] = node_pool_alloc(&pool);
+    const struct node_pool_slab* slabs = pool.slabs;
+    node_pool_release_array(&pool, nodes, TEST_POOL_LENGTH);
+    result = pool.length == 0;
+    for(int i = 0; i < TEST_POOL_LENGTH; i++) result &= node_pool_alloc(&pool) != NULL;
+    test(result && pool.slabs == slabs, "`ID_pool_release_array`.");
+    node_pool_free_items(&pool);
+}
+
+/* >> test_pool_clear
+ *  Test `ID_pool_clear` function.
+ *  This depends on `ID_pool_alloc` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_pool_clear() {
+    struct node_pool pool = {0};
+    bool result = true;
+    for(int i = 0; i < TEST_POOL_LENGTH; i++) node_pool_alloc(&pool);
+    const struct node_pool_slab* slabs = pool.slabs;
+    node_pool_clear(&pool);
+    result = pool.length == 0;
+    for(int i = 0; i < TEST_POOL_LENGTH; i++) result &= node_pool_alloc(&pool) != NULL;
+    test(result && pool.slabs == slabs, "`ID_pool_clear`.");
+    node_pool_free_items(&pool);
+}
+
+struct test_pool_worker {
+    pthread_t thread;
+    struct node_pool* pool;
+    bool result;
+};
+
+/* Worker thread, builds and tears down a linked list with its own cache. */
+static void* test_pool_work(void* p_worker) {
+    struct test_pool_worker* worker = p_worker;
+    struct node_pool_cache cache = {.pool = worker->pool};
+    struct test_pool_node* head = NULL;
+    worker->result = true;
+    for(int round = 0; round < 10; round++) {
+        for(int i = 0; i < TEST_POOL_LENGTH; i++) {
+            struct test_pool_node* node = node_pool_cache_alloc(&cache);
+            if(!node) { worker->result = false; break; }
+            node->value = i;
+            node->next = head;
+            head = node;
+        }
+        for(int i = TEST_POOL_LENGTH - 1; head; i--) {
+            struct test_pool_node* next = head->next;
+            worker->result &= head->value == i;
+            node_pool_cache_release(&cache, head);
+            head = next;
+        }
+    }
+    node_pool_cache_flush(&cache);
+    return NULL;
+}
+
+/* >> test_pool_cache
+ *  Test `ID_pool_cache_alloc`, `ID_pool_cache_release` &
+ *  `ID_pool_cache_flush` functions from many threads sharing a pool.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_pool_cache() {
+    struct node_pool pool = {0};
+    struct test_pool_worker workers[TEST_POOL_THREAD_COUNT];
+    bool result = true;
+    for(int i = 0; i < TEST_POOL_THREAD_COUNT; i++) {
+        workers[i].pool = &pool;
+        pthread_create(&workers[i].thread, NULL, test_pool_work, workers + i);
+    }
+    for(int i = 0; i < TEST_POOL_THREAD_COUNT; i++) {
+        pthread_join(workers[i].thread, NULL);
+        result &= workers[i].result;
+    }
+    test(result && pool.length == 0, "`ID_pool_cache_alloc` from many threads.");
+    node_pool_free_items(&pool);
+}
+
+/* >> test_pool_list
+ *  Test `ID_list_new` drawing the list structures from a pool.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_pool_list() {
+    struct int_list* lists[TEST_POOL_LENGTH];
+    bool result = true;
+    for(int i = 0; i < TEST_POOL_LENGTH; i++) {
+        lists[i] = int_list_new();
+        result &= lists[i] && int_list_length(lists[i]) == 0 && int_list_append(lists[i], i);
+    }
+    test(result && int_list_pool.length == TEST_POOL_LENGTH, "`ID_list_new` from pool.");
+    for(int i = 0; i < TEST_POOL_LENGTH; i++) int_list_free(lists[i]);
+    test(int_list_pool.length == 0, "`ID_list_free` to pool.");
+    int_list_pool_free_items(&int_list_pool);
+}
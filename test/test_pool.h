@@ -0,0 +1,6 @@
+#ifndef _TEST_POOL_H_
+#define _TEST_POOL_H_
+
+void test_pool(); 
+
+#endif //_TEST_POOL_H_
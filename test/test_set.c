@@ -0,0 +1,181 @@
+#include <set.h>
+#include <test.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "test_set.h"
+
+#define TEST_SET_LENGTH 10000
+
+SET_DEFINE_STRUCT(int, int, );
+SET_DEFINE_FUNCTION(int, int, set_hash_integer, SET_EQUAL_PRIMITIVE, static);
+
+static void test_set_insert();
+static void test_set_contains();
+static void test_set_erase();
+static void test_set_reserve();
+static void test_set_insert_array();
+static void test_set_contains_array();
+
+/* >> test_set
+ *  entrance for testing set.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+void test_set() {
+    test_start("Test set."); 
+    test_set_insert();
+    test_set_contains();
+    test_set_erase();
+    test_set_reserve();
+    test_set_insert_array();
+    test_set_contains_array();
+    test_end();
+}
+
+/* >> test_set_insert
+ *  Test `ID_set_insert` function, growing from an empty set.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_set_insert() {
+    struct int_set* set = int_set_new();
+    bool is_new = false;
+    bool result = true;
+    for(int i = 0; i < TEST_SET_LENGTH; i++)
+        result &= int_set_insert(set, i * 3, &is_new) && is_new;
+    test(result && int_set_length(set) == TEST_SET_LENGTH, "`ID_set_insert` with new items.");
+    result = int_set_insert(set, 30, &is_new);
+    test(result && !is_new && int_set_length(set) == TEST_SET_LENGTH, "`ID_set_insert` with existing item.");
+    int_set_free(set);
+}
+
+/* >> test_set_contains
+ *  Test `ID_set_contains` function.
+ *  This depends on `ID_set_insert` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_set_contains() {
+    struct int_set set = {0};
+    bool result = !int_set_contains(&set, 0);
+    test(result, "`ID_set_contains` on empty set.");
+    for(int i = 0; i < TEST_SET_LENGTH; i++) int_set_insert(&set, i * 3, NULL);
+    for(int i = 0; i < TEST_SET_LENGTH * 3; i++)
+        result &= int_set_contains(&set, i) == !(i % 3);
+    test(result, "`ID_set_contains` with existing and non-existing items.");
+    int_set_free_items(&set);
+}
+
+/* >> test_set_erase
+ *  Test `ID_set_erase` function, including reuse of erased slots.
+ *  This depends on `ID_set_insert` & `ID_set_contains` functions.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_set_erase() {
+    struct int_set set = {0};
+    bool result = true;
+    for(int i = 0; i < TEST_SET_LENGTH; i++) int_set_insert(&set, i, NULL);
+    for(int i = 0; i < TEST_SET_LENGTH; i += 2) result &= int_set_erase(&set, i);
+    for(int i = 0; i < TEST_SET_LENGTH; i++) result &= int_set_contains(&set, i) == (i % 2);
+    test(result && int_set_length(&set) == TEST_SET_LENGTH / 2, "`ID_set_erase` with existing items.");
+    result = int_set_erase(&set, 0);
+    test(!result && int_set_length(&set) == TEST_SET_LENGTH / 2, "`ID_set_erase` with non-existing item.");
+
+    /* Churn without growing, erased slots must be reclaimed. */
+    const list_uint capacity = set.capacity;
+    for(int i = 0; i < TEST_SET_LENGTH * 10; i++) {
+        int_set_insert(&set, TEST_SET_LENGTH + i, NULL);
+        int_set_erase(&set, TEST_SET_LENGTH + i);
+    }
+    test(set.capacity == capacity && int_set_length(&set) == TEST_SET_LENGTH / 2, "`ID_set_erase` with churn.");
+    int_set_free_items(&set);
+}
+
+/* >> test_set_reserve
+ *  Test `ID_set_reserve` function.
+ *  This depends on `ID_set_insert` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_set_reserve() {
+    struct int_set set = {0};
+    bool result = int_set_reserve(&set, TEST_SET_LENGTH);
+    int8_t* controls = set.controls;
+    for(int i = 0; i < TEST_SET_LENGTH; i++) result &= int_set_insert(&set, i, NULL);
+    test(result && set.controls == controls, "`ID_set_reserve`.");
+    int_set_free_items(&set);
+}
+
+/* >> test_set_insert_array
+ *  Test `ID_set_insert_array` function with duplicates.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_set_insert_array() {
+    int array[TEST_SET_LENGTH];
+    bool is_new[TEST_SET_LENGTH];
+    struct int_set set = {0};
+    bool result = false;
+    for(int i = 0; i < TEST_SET_LENGTH; i++) array[i] = i / 2;
+    result = int_set_insert_array(&set, array, TEST_SET_LENGTH, is_new);
+    for(int i = 0; i < TEST_SET_LENGTH; i++) result &= is_new[i] == !(i % 2);
+    test(result && int_set_length(&set) == TEST_SET_LENGTH / 2, "`ID_set_insert_array`.");
+    int_set_free_items(&set);
+}
+
+/* >> test_set_contains_array
+ *  Test `ID_set_contains_array` function.
+ *  This depends on `ID_set_insert` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_set_contains_array() {
+    int array[TEST_SET_LENGTH];
+    bool results[TEST_SET_LENGTH];
+    struct int_set set = {0};
+    bool result = true;
+    for(int i = 0; i < TEST_SET_LENGTH; i++) {
+        array[i] = i;
+        if(i % 4 == 0) int_set_insert(&set, i, NULL);
+    }
+    result = int_set_contains_array(&set, array, TEST_SET_LENGTH, results) == TEST_SET_LENGTH / 4;
+    for(int i = 0; i < TEST_SET_LENGTH; i++) result &= results[i] == !(i % 4);
+    test(result, "`ID_set_contains_array`.");
+    int_set_free_items(&set);
+}
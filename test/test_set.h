@@ -0,0 +1,6 @@
+#ifndef _TEST_SET_H_
+#define _TEST_SET_H_
+
+void test_set(); 
+
+#endif //_TEST_SET_H_
@@ -0,0 +1,197 @@
+#include <sorted_list.h>
+#include <list.h>
+#include <test.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "test_sorted_list.h"
+
+#define TEST_SORTED_LIST_LENGTH 1000
+
+LIST_DEFINE_STRUCT(int, int, );
+LIST_DEFINE_GETTER(int, int, static inline);
+LIST_DEFINE_SETTER(int, int, static inline);
+SORTED_LIST_DEFINE_FUNCTION(int, int, static inline);
+
+static void test_sorted_list_intersect();
+static void test_sorted_list_union();
+static void test_sorted_list_difference();
+static void test_sorted_list_merge();
+
+/* Fill the list with multiples of `p_step` from 0. */
+static void test_sorted_list_fill(struct int_list* r_list, int p_step, list_uint p_length) {
+    for(list_uint i = 0; i < p_length; i++) int_list_append(r_list, (int)i * p_step);
+}
+
+/* Check the list is multiples of `p_step` from 0, except ones of `p_skip`. */
+static bool test_sorted_list_check(const struct int_list* p_list, int p_step, int p_skip, int p_end) {
+    list_uint index = 0;
+    for(int item = 0; item < p_end; item += p_step) {
+        if(p_skip && !(item % p_skip)) continue;
+        if(index >= p_list->length || p_list->items[index++] != item) return false;
+    }
+    return index == p_list->length;
+}
+
+/* >> test_sorted_list
+ *  entrance for testing sorted list.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+void test_sorted_list() {
+    test_start("Test sorted list."); 
+    test_sorted_list_intersect();
+    test_sorted_list_union();
+    test_sorted_list_difference();
+    test_sorted_list_merge();
+    test_end();
+}
+
+/* >> test_sorted_list_intersect
+ *  Test `ID_list_intersect` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_sorted_list_intersect() {
+    struct int_list a = {0};
+    struct int_list b = {0};
+    struct int_list output = {0};
+    test_sorted_list_fill(&a, 2, TEST_SORTED_LIST_LENGTH);
+    test_sorted_list_fill(&b, 3, TEST_SORTED_LIST_LENGTH);
+    bool result = int_list_intersect(&a, &b, &output);
+    test(result && test_sorted_list_check(&output, 6, 0, 2 * TEST_SORTED_LIST_LENGTH), "`ID_list_intersect` with lists of similar length.");
+    int_list_free_items(&a);
+    a = (struct int_list){0};
+    output.length = 0;
+    test_sorted_list_fill(&a, 100, 10);
+    result = int_list_intersect(&a, &b, &output);
+    test(result && test_sorted_list_check(&output, 300, 0, 1000), "`ID_list_intersect` with lists of skewed length.");
+    result = int_list_intersect(&b, &a, &output);
+    test(result && output.length == 8 && output.items[4] == 0 && output.items[7] == 900, "`ID_list_intersect` appending to non-empty output.");
+    a.length = 0;
+    output.length = 0;
+    result = int_list_intersect(&a, &b, &output);
+    test(result && output.length == 0, "`ID_list_intersect` with empty list.");
+    int_list_free_items(&a);
+    int_list_free_items(&b);
+    int_list_free_items(&output);
+}
+
+/* >> test_sorted_list_union
+ *  Test `ID_list_union` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_sorted_list_union() {
+    struct int_list a = {0};
+    struct int_list b = {0};
+    struct int_list output = {0};
+    test_sorted_list_fill(&a, 2, TEST_SORTED_LIST_LENGTH);
+    test_sorted_list_fill(&b, 4, TEST_SORTED_LIST_LENGTH);
+    bool result = int_list_union(&a, &b, &output);
+    bool is_valid = output.length == TEST_SORTED_LIST_LENGTH + TEST_SORTED_LIST_LENGTH / 2;
+    for(list_uint i = 0; is_valid && i < output.length; i++)
+        is_valid = output.items[i] == (i < TEST_SORTED_LIST_LENGTH? 2 * (int)i: 4 * ((int)i - TEST_SORTED_LIST_LENGTH / 2));
+    test(result && is_valid, "`ID_list_union` with overlapping lists.");
+    a.length = 0;
+    output.length = 0;
+    result = int_list_union(&a, &b, &output);
+    test(result && test_sorted_list_check(&output, 4, 0, 4 * TEST_SORTED_LIST_LENGTH), "`ID_list_union` with empty list.");
+    struct int_list empty = {0};
+    output.length = 0;
+    result = int_list_union(&empty, &b, &output) && int_list_union(&b, &empty, &output) && int_list_union(&empty, &empty, &output);
+    test(result && output.length == 2 * TEST_SORTED_LIST_LENGTH, "`ID_list_union` with unallocated list.");
+    int_list_free_items(&a);
+    int_list_free_items(&b);
+    int_list_free_items(&output);
+}
+
+/* >> test_sorted_list_difference
+ *  Test `ID_list_difference` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_sorted_list_difference() {
+    struct int_list a = {0};
+    struct int_list b = {0};
+    struct int_list output = {0};
+    test_sorted_list_fill(&a, 2, TEST_SORTED_LIST_LENGTH);
+    test_sorted_list_fill(&b, 3, TEST_SORTED_LIST_LENGTH);
+    bool result = int_list_difference(&a, &b, &output);
+    test(result && test_sorted_list_check(&output, 2, 3, 2 * TEST_SORTED_LIST_LENGTH), "`ID_list_difference` with lists of similar length.");
+    int_list_free_items(&a);
+    a = (struct int_list){0};
+    output.length = 0;
+    test_sorted_list_fill(&a, 100, 30);
+    result = int_list_difference(&a, &b, &output);
+    test(result && test_sorted_list_check(&output, 100, 3, 3000), "`ID_list_difference` with lists of skewed length.");
+    output.length = 0;
+    result = int_list_difference(&b, &b, &output);
+    test(result && output.length == 0, "`ID_list_difference` with the same list.");
+    struct int_list empty = {0};
+    result = int_list_difference(&b, &empty, &output) && int_list_difference(&empty, &b, &output);
+    result &= int_list_intersect(&b, &empty, &output);
+    test(result && test_sorted_list_check(&output, 3, 0, 3 * TEST_SORTED_LIST_LENGTH), "`ID_list_difference` with unallocated list.");
+    int_list_free_items(&a);
+    int_list_free_items(&b);
+    int_list_free_items(&output);
+}
+
+/* >> test_sorted_list_merge
+ *  Test `ID_list_merge` function.
+ *
+ * @noparam 
+ *
+ * @noreturn 
+ *
+ * @noerror
+ * <<
+ * */
+static void test_sorted_list_merge() {
+    struct int_list lists[5] = {{0}};
+    const struct int_list* inputs[5];
+    struct int_list output = {0};
+    for(int i = 0; i < 5; i++) {
+        for(int item = i; item < 5 * TEST_SORTED_LIST_LENGTH; item += 5) int_list_append(&lists[i], item);
+        inputs[i] = &lists[i];
+    }
+    bool result = int_list_merge(inputs, 5, &output);
+    test(result && test_sorted_list_check(&output, 1, 0, 5 * TEST_SORTED_LIST_LENGTH), "`ID_list_merge` with interleaved lists.");
+    output.length = 0;
+    lists[1].length = 0;
+    result = int_list_merge(inputs, 3, &output);
+    bool is_valid = output.length == 2 * TEST_SORTED_LIST_LENGTH;
+    for(list_uint i = 1; is_valid && i < output.length; i++) is_valid = output.items[i - 1] < output.items[i];
+    test(result && is_valid, "`ID_list_merge` with an empty list.");
+    output.length = 0;
+    result = int_list_merge(inputs + 2, 2, &output) && int_list_merge(inputs + 2, 2, &output);
+    is_valid = output.length == 4 * TEST_SORTED_LIST_LENGTH && output.items[0] == 2 && output.items[1] == 3 && output.items[2 * TEST_SORTED_LIST_LENGTH] == 2;
+    test(result && is_valid, "`ID_list_merge` appending to non-empty output.");
+    output.length = 0;
+    result = int_list_merge(inputs, 1, &output);
+    test(result && test_sorted_list_check(&output, 5, 0, 5 * TEST_SORTED_LIST_LENGTH), "`ID_list_merge` with one list.");
+    output.length = 0;
+    result = int_list_merge(inputs, 0, &output);
+    test(result && output.length == 0, "`ID_list_merge` with no list.");
+    for(int i = 0; i < 5; i++) int_list_free_items(&lists[i]);
+    int_list_free_items(&output);
+}
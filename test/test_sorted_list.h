@@ -0,0 +1,6 @@
+#ifndef _TEST_SORTED_LIST_H_
+#define _TEST_SORTED_LIST_H_
+
+void test_sorted_list(); 
+
+#endif //_TEST_SORTED_LIST_H_